@@ -0,0 +1,388 @@
+using System.Collections.Generic;
+using System.Linq;
+using System.Text;
+using Microsoft.CodeAnalysis;
+
+namespace Plugify.Generators;
+
+/// <summary>
+/// Native entry point generated for one [NativeExport] method.
+/// </summary>
+internal sealed class ExportStub
+{
+    public string FuncName { get; set; } = "";
+    public string StubName { get; set; } = "";
+    public string FunctionPointerType { get; set; } = "";
+    public ulong Signature { get; set; }
+    public string Source { get; set; } = "";
+}
+
+/// <summary>
+/// Emits an [UnmanagedCallersOnly] wrapper with the native signature plugify
+/// calls an export with, so the language module can hand its address out as is
+/// instead of resolving the method by reflection and marshalling every call.
+/// </summary>
+internal static class ExportStubEmitter
+{
+    private const string NativeMethods = "global::Plugify.NativeMethods";
+    private const string NativeMethodsT = "global::Plugify.NativeMethodsT";
+    private const string Marshalling = "global::Plugify.Marshalling";
+
+    private enum Kind
+    {
+        Void,
+        Value,
+        Boolean,
+        Struct,
+        String,
+        Any,
+        Array,
+        Delegate
+    }
+
+    private sealed class TypeInfo
+    {
+        public Kind Kind { get; set; }
+        public string Name { get; set; } = "";
+        // Array helpers only
+        public string Suffix { get; set; } = "";
+        public string ElementName { get; set; } = "";
+        public bool IsEnumArray { get; set; }
+    }
+
+    public static ExportStub? Create(IMethodSymbol method, string funcName)
+    {
+        if (!IsAccessible(method))
+            return null;
+
+        var returnType = Classify(method.ReturnType, method.ReturnsVoid);
+        if (returnType == null)
+            return null;
+
+        var stubName = "__" + funcName.Replace('.', '_');
+
+        var parameters = new List<string>();
+        var pointerTypes = new List<string>();
+        var arguments = new List<string>();
+        var prologue = new StringBuilder();
+        var epilogue = new StringBuilder();
+
+        for (int i = 0; i < method.Parameters.Length; i++)
+        {
+            var parameter = method.Parameters[i];
+            var type = Classify(parameter.Type, false);
+            if (type == null)
+                return null;
+
+            var name = "@" + parameter.Name;
+            var local = $"__{i}";
+            var refKind = parameter.RefKind switch
+            {
+                RefKind.None => "",
+                RefKind.Ref => "ref ",
+                RefKind.Out => "out ",
+                RefKind.In => "in ",
+                _ => null
+            };
+            if (refKind == null)
+                return null;
+
+            bool byRef = refKind.Length != 0;
+            string nativeType;
+
+            switch (type.Kind)
+            {
+                case Kind.Value:
+                    nativeType = byRef ? type.Name + "*" : type.Name;
+                    arguments.Add(byRef ? $"{refKind}*{name}" : name);
+                    break;
+                case Kind.Boolean:
+                    nativeType = byRef ? "bool*" : "byte";
+                    arguments.Add(byRef ? $"{refKind}*{name}" : $"{name} != 0");
+                    break;
+                case Kind.Struct:
+                    // plugify always passes vectors and matrices by address
+                    nativeType = type.Name + "*";
+                    arguments.Add(byRef ? $"{refKind}*{name}" : $"*{name}");
+                    break;
+                case Kind.Delegate:
+                    if (byRef)
+                        return null;
+                    nativeType = "nint";
+                    prologue.AppendLine($"var {local} = {Marshalling}.GetDelegateForFunctionPointer<{type.Name}>({name});");
+                    arguments.Add(local);
+                    break;
+                default:
+                    nativeType = NativeStorage(type) + "*";
+                    prologue.AppendLine($"var {local} = {ReadObject(type, name)};");
+                    arguments.Add(refKind + local);
+                    if (byRef)
+                        epilogue.AppendLine(WriteObject(type, name, local));
+                    break;
+            }
+
+            parameters.Add($"{nativeType} {name}");
+            pointerTypes.Add(nativeType);
+        }
+
+        var call = $"{method.ContainingType.ToDisplayString(SymbolDisplayFormat.FullyQualifiedFormat)}.{method.Name}({string.Join(", ", arguments)})";
+        string nativeReturn;
+        string invoke;
+        string fallback = "default";
+
+        switch (returnType.Kind)
+        {
+            case Kind.Void:
+                nativeReturn = "void";
+                invoke = $"{call};";
+                fallback = "";
+                break;
+            case Kind.Value:
+            case Kind.Struct:
+                nativeReturn = returnType.Name;
+                invoke = $"var __ret = {call};";
+                epilogue.AppendLine("return __ret;");
+                break;
+            case Kind.Boolean:
+                nativeReturn = "byte";
+                invoke = $"var __ret = {call};";
+                epilogue.AppendLine("return (byte)(__ret ? 1 : 0);");
+                break;
+            case Kind.Delegate:
+                nativeReturn = "nint";
+                invoke = $"var __ret = {call};";
+                epilogue.AppendLine($"return __ret != null ? {Marshalling}.GetFunctionPointerForDelegate(__ret) : 0;");
+                break;
+            default:
+                // objects are returned by value, the caller owns the constructed storage
+                nativeReturn = NativeStorage(returnType);
+                invoke = $"var __ret = {call};";
+                epilogue.AppendLine($"return {ConstructObject(returnType, "__ret", true)};");
+                fallback = returnType.Kind == Kind.Array
+                    ? ConstructObject(returnType, $"global::System.Array.Empty<{returnType.ElementName}>()", false)
+                    : ConstructObject(returnType, "null", false);
+                break;
+        }
+
+        pointerTypes.Add(nativeReturn);
+
+        var body = new StringBuilder();
+        body.AppendLine("[UnmanagedCallersOnly(CallConvs = new[] { typeof(CallConvCdecl) })]");
+        body.AppendLine($"private static {nativeReturn} {stubName}({string.Join(", ", parameters)})");
+        body.AppendLine("{");
+        body.AppendLine("    try");
+        body.AppendLine("    {");
+        AppendIndented(body, prologue.ToString(), 8);
+        body.AppendLine($"        {invoke}");
+        AppendIndented(body, epilogue.ToString(), 8);
+        body.AppendLine("    }");
+        body.AppendLine("    catch (Exception __e)");
+        body.AppendLine("    {");
+        body.AppendLine("        global::Plugify.NativeExports.HandleException(__e);");
+        body.AppendLine(fallback.Length == 0 ? "        return;" : $"        return {fallback};");
+        body.AppendLine("    }");
+        body.AppendLine("}");
+
+        return new ExportStub
+        {
+            FuncName = funcName,
+            StubName = stubName,
+            FunctionPointerType = $"delegate* unmanaged[Cdecl]<{string.Join(", ", pointerTypes)}>",
+            Source = body.ToString()
+        };
+    }
+
+    public static string GenerateSource(string assemblyName, IEnumerable<ExportStub> stubs)
+    {
+        var ordered = stubs.OrderBy(s => s.FuncName, System.StringComparer.Ordinal).ToList();
+
+        var entries = new StringBuilder();
+        var methods = new StringBuilder();
+        foreach (var stub in ordered)
+        {
+            entries.AppendLine($"            new(\"{stub.FuncName}\", (nint)({stub.FunctionPointerType})&{stub.StubName}, 0x{stub.Signature:X16}UL),");
+            methods.AppendLine();
+            AppendIndented(methods, stub.Source, 8);
+        }
+
+        return $$"""
+                 // <auto-generated/>
+                 #nullable enable
+
+                 using System;
+                 using System.Runtime.CompilerServices;
+                 using System.Runtime.InteropServices;
+
+                 namespace Plugify.Generated
+                 {
+                     /// <summary>
+                     /// Auto-generated native entry points for {{assemblyName}}
+                     /// </summary>
+                     internal static unsafe class PlugifyExports
+                     {
+                         /// <summary>
+                         /// Export table read by the language module when the plugin is loaded
+                         /// </summary>
+                         internal static global::Plugify.NativeExportEntry[] GetExports() => new global::Plugify.NativeExportEntry[]
+                         {
+                 {{entries}}        };
+                 {{methods}}    }
+                 }
+
+                 """;
+    }
+
+    private static void AppendIndented(StringBuilder builder, string text, int indent)
+    {
+        var padding = new string(' ', indent);
+        foreach (var line in text.Split('\n'))
+        {
+            var trimmed = line.TrimEnd('\r');
+            if (trimmed.Length != 0)
+                builder.Append(padding).AppendLine(trimmed);
+        }
+    }
+
+    private static bool IsAccessible(IMethodSymbol method)
+    {
+        if (!IsVisible(method.DeclaredAccessibility) || method.IsGenericMethod)
+            return false;
+
+        for (var type = method.ContainingType; type != null; type = type.ContainingType)
+        {
+            if (!IsVisible(type.DeclaredAccessibility) || type.IsGenericType)
+                return false;
+        }
+
+        return true;
+    }
+
+    private static bool IsVisible(Accessibility accessibility)
+    {
+        return accessibility is Accessibility.Public or Accessibility.Internal or Accessibility.ProtectedOrInternal;
+    }
+
+    private static TypeInfo? Classify(ITypeSymbol type, bool isVoid)
+    {
+        if (isVoid)
+            return new TypeInfo { Kind = Kind.Void };
+
+        var name = type.ToDisplayString(SymbolDisplayFormat.FullyQualifiedFormat);
+
+        if (type.TypeKind == TypeKind.Delegate)
+            return new TypeInfo { Kind = Kind.Delegate, Name = name };
+
+        // Views over the caller's vector are built by the language module's thunks, not by a stub
+        if (ManifestFileGenerator.GetSpanElementType(type) != null ||
+            ManifestFileGenerator.GetNativeVectorElementType(type) != null)
+            return null;
+
+        if (type.TypeKind == TypeKind.Enum)
+            return new TypeInfo { Kind = Kind.Value, Name = name };
+
+        if (type is IArrayTypeSymbol arrayType)
+        {
+            var element = arrayType.ElementType;
+            var elementName = element.ToDisplayString(SymbolDisplayFormat.FullyQualifiedFormat);
+            if (element.TypeKind == TypeKind.Enum && element is INamedTypeSymbol { EnumUnderlyingType: { } underlying })
+            {
+                var suffix = VectorSuffix(underlying.ToDisplayString());
+                return suffix is null || !suffix.Contains("Int")
+                    ? null
+                    : new TypeInfo { Kind = Kind.Array, Name = name, Suffix = suffix, ElementName = elementName, IsEnumArray = true };
+            }
+
+            var elementSuffix = VectorSuffix(element.ToDisplayString());
+            return elementSuffix is null
+                ? null
+                : new TypeInfo { Kind = Kind.Array, Name = name, Suffix = elementSuffix, ElementName = elementName };
+        }
+
+        return type.ToDisplayString() switch
+        {
+            "bool" => new TypeInfo { Kind = Kind.Boolean, Name = name },
+            "Plugify.Bool8" or "Plugify.Char8" or "Plugify.Char16" or
+            "sbyte" or "short" or "int" or "long" or
+            "byte" or "ushort" or "uint" or "ulong" or
+            "nint" or "System.IntPtr" or "float" or "double" => new TypeInfo { Kind = Kind.Value, Name = name },
+            "System.Numerics.Vector2" or "System.Numerics.Vector3" or
+            "System.Numerics.Vector4" or "System.Numerics.Matrix4x4" => new TypeInfo { Kind = Kind.Struct, Name = name },
+            "string" => new TypeInfo { Kind = Kind.String, Name = name },
+            "object" => new TypeInfo { Kind = Kind.Any, Name = name },
+            _ => null
+        };
+    }
+
+    private static string? VectorSuffix(string elementName)
+    {
+        return elementName switch
+        {
+            "Plugify.Bool8" => "Bool",
+            "Plugify.Char8" => "Char8",
+            "Plugify.Char16" => "Char16",
+            "sbyte" => "Int8",
+            "short" => "Int16",
+            "int" => "Int32",
+            "long" => "Int64",
+            "byte" => "UInt8",
+            "ushort" => "UInt16",
+            "uint" => "UInt32",
+            "ulong" => "UInt64",
+            "nint" or "System.IntPtr" => "IntPtr",
+            "float" => "Float",
+            "double" => "Double",
+            "string" => "String",
+            "object" => "Variant",
+            "System.Numerics.Vector2" => "Vector2",
+            "System.Numerics.Vector3" => "Vector3",
+            "System.Numerics.Vector4" => "Vector4",
+            "System.Numerics.Matrix4x4" => "Matrix4x4",
+            _ => null
+        };
+    }
+
+    private static string NativeStorage(TypeInfo type)
+    {
+        return type.Kind switch
+        {
+            Kind.String => "global::Plugify.String192",
+            Kind.Any => "global::Plugify.Variant256",
+            _ => "global::Plugify.Vector192"
+        };
+    }
+
+    private static string ReadObject(TypeInfo type, string pointer)
+    {
+        return type.Kind switch
+        {
+            Kind.String => $"{NativeMethods}.GetStringData({pointer})",
+            Kind.Any => $"{NativeMethods}.GetVariantData({pointer})",
+            _ when type.IsEnumArray => $"{NativeMethodsT}.GetVectorData{type.Suffix}<{type.ElementName}>({pointer})",
+            _ => $"{NativeMethods}.GetVectorData{type.Suffix}({pointer})"
+        };
+    }
+
+    private static string WriteObject(TypeInfo type, string pointer, string value)
+    {
+        return type.Kind switch
+        {
+            Kind.String => $"{NativeMethods}.AssignString({pointer}, {value});",
+            Kind.Any => $"{NativeMethods}.AssignVariant({pointer}, {value});",
+            _ when type.IsEnumArray => $"if ({value} != null) {NativeMethodsT}.AssignVector{type.Suffix}<{type.ElementName}>({pointer}, {value});",
+            _ => $"if ({value} != null) {NativeMethods}.AssignVector{type.Suffix}({pointer}, {value});"
+        };
+    }
+
+    private static string ConstructObject(TypeInfo type, string value, bool nullable)
+    {
+        var array = nullable ? $"{value} ?? global::System.Array.Empty<{type.ElementName}>()" : value;
+        var length = nullable ? $"{value}?.Length ?? 0" : $"{value}.Length";
+        return type.Kind switch
+        {
+            Kind.String => $"{NativeMethods}.ConstructString({value})",
+            Kind.Any => $"{NativeMethods}.ConstructVariant({value})",
+            _ when type.IsEnumArray => $"{NativeMethodsT}.ConstructVector{type.Suffix}<{type.ElementName}>({array}, {length})",
+            _ => $"{NativeMethods}.ConstructVector{type.Suffix}({array})"
+        };
+    }
+}
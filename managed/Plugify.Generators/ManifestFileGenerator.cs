@@ -8,6 +8,7 @@ using System.Text.Json;
 using System.Text.Json.Serialization;
 using System.Threading;
 using Microsoft.CodeAnalysis;
+using Microsoft.CodeAnalysis.CSharp;
 using Microsoft.CodeAnalysis.CSharp.Syntax;
 
 namespace Plugify.Generators;
@@ -79,24 +80,76 @@ public class ManifestFileGenerator : IIncrementalGenerator
         if (string.IsNullOrEmpty(exportName))
             return null;
 
+        var methodName = GetFullMethodName(methodSymbol);
+
+        var parameters = methodSymbol.Parameters
+            .Select(p => new MethodParameter
+            {
+                Name = p.Name,
+                Type = MapTypeToPlugify(p.Type),
+                IsRef = IsByRef(p)
+            })
+            .ToList();
+
+        // Async exports return void to the caller and hand the awaited result to a trailing completion callback
+        var returnType = MapTypeToPlugify(methodSymbol.ReturnType);
+        if (TryGetTaskResult(methodSymbol.ReturnType, out var resultType))
+        {
+            returnType = new PlugifyType { TypeName = "void" };
+            parameters.Add(new MethodParameter
+            {
+                Name = "completion",
+                Type = new PlugifyType
+                {
+                    TypeName = "function",
+                    IsDelegate = true,
+                    DelegateName = exportName + "Completion",
+                    DelegateReturnType = new PlugifyType { TypeName = "void" },
+                    DelegateParameters = resultType is null
+                        ? []
+                        : [new MethodParameter { Name = "result", Type = MapTypeToPlugify(resultType) }]
+                }
+            });
+        }
+
         var method = new ExportedMethod
         {
             ExportName = exportName!,
-            MethodName = GetFullMethodName(methodSymbol),
-            ReturnType = MapTypeToPlugify(methodSymbol.ReturnType),
-            Parameters = methodSymbol.Parameters
-                .Select(p => new MethodParameter
-                {
-                    Name = p.Name,
-                    Type = MapTypeToPlugify(p.Type),
-                    IsRef = p.RefKind == RefKind.Ref
-                })
-                .ToList()
+            MethodName = methodName,
+            ReturnType = returnType,
+            Parameters = parameters,
+            Stub = ExportStubEmitter.Create(methodSymbol, methodName)
         };
 
+        // The language module only trusts a stub whose signature still matches the manifest it was loaded with
+        if (method.Stub != null)
+        {
+            method.Stub.Signature = HashSignature(method.ReturnType, method.Parameters);
+        }
+
         return method;
     }
 
+    private static bool TryGetTaskResult(ITypeSymbol typeSymbol, out ITypeSymbol? resultType)
+    {
+        resultType = null;
+        if (typeSymbol is not INamedTypeSymbol namedType)
+            return false;
+
+        switch (namedType.OriginalDefinition.ToDisplayString())
+        {
+            case "System.Threading.Tasks.Task":
+            case "System.Threading.Tasks.ValueTask":
+                return true;
+            case "System.Threading.Tasks.Task<TResult>":
+            case "System.Threading.Tasks.ValueTask<TResult>":
+                resultType = namedType.TypeArguments[0];
+                return true;
+            default:
+                return false;
+        }
+    }
+
     private static string GetFullMethodName(IMethodSymbol methodSymbol)
     {
         var containingType = methodSymbol.ContainingType;
@@ -123,6 +176,30 @@ public class ManifestFileGenerator : IIncrementalGenerator
             };
         }
 
+        // A span views the incoming vector in place, to the caller it is the matching array
+        if (GetSpanElementType(typeSymbol) is { } spanElementType)
+        {
+            var elementType = MapTypeToPlugify(spanElementType);
+            return new PlugifyType
+            {
+                TypeName = elementType.TypeName + "[]",
+                IsArray = true,
+                ElementType = elementType
+            };
+        }
+
+        // A NativeVector edits the caller's vector in place, to the caller it is the matching by-ref array
+        if (GetNativeVectorElementType(typeSymbol) is { } vectorElementType)
+        {
+            var elementType = MapTypeToPlugify(vectorElementType);
+            return new PlugifyType
+            {
+                TypeName = elementType.TypeName + "[]",
+                IsArray = true,
+                ElementType = elementType
+            };
+        }
+
         // Handle delegates (function pointers)
         if (typeSymbol.TypeKind == TypeKind.Delegate)
         {
@@ -143,7 +220,7 @@ public class ManifestFileGenerator : IIncrementalGenerator
                         {
                             Name = p.Name,
                             Type = MapTypeToPlugify(p.Type),
-                            IsRef = p.RefKind == RefKind.Ref
+                            IsRef = IsByRef(p)
                         })
                         .ToList()
                 };
@@ -204,7 +281,7 @@ public class ManifestFileGenerator : IIncrementalGenerator
             "System.IntPtr" when IntPtr.Size == 4 => "ptr32",
             "float" => "float",
             "double" => "double",
-            "string" => "string",
+            "string" or "Plugify.NativeStringView" => "string",
             "object" => "any",
             "System.Numerics.Vector2" => "vec2",
             "System.Numerics.Vector3" => "vec3",
@@ -216,6 +293,89 @@ public class ManifestFileGenerator : IIncrementalGenerator
         return new PlugifyType { TypeName = plugifyTypeName };
     }
 
+    // Element types laid out exactly like their native counterpart, kept in step with TypeUtils.SpanElementTypes
+    private static readonly HashSet<string> SpanElementTypes =
+    [
+        "Plugify.Char8", "Plugify.Char16",
+        "sbyte", "short", "int", "long",
+        "byte", "ushort", "uint", "ulong",
+        "nint", "System.IntPtr", "float", "double",
+        "System.Numerics.Vector2", "System.Numerics.Vector3", "System.Numerics.Vector4", "System.Numerics.Matrix4x4"
+    ];
+
+    /// <summary>
+    /// Element type of a Span&lt;T&gt; or ReadOnlySpan&lt;T&gt; that can view a native vector, null for any other type.
+    /// </summary>
+    internal static ITypeSymbol? GetSpanElementType(ITypeSymbol typeSymbol)
+    {
+        return GetViewElementType(typeSymbol, "System.Span<T>", "System.ReadOnlySpan<T>");
+    }
+
+    /// <summary>
+    /// Element type of a NativeVector&lt;T&gt; over a by-ref native vector, null for any other type.
+    /// </summary>
+    internal static ITypeSymbol? GetNativeVectorElementType(ITypeSymbol typeSymbol)
+    {
+        return GetViewElementType(typeSymbol, "Plugify.NativeVector<T>");
+    }
+
+    /// <summary>
+    /// A NativeVector stands for a by-ref array, so the manifest has to describe it as passed by reference too.
+    /// </summary>
+    private static bool IsByRef(IParameterSymbol parameter)
+    {
+        return parameter.RefKind != RefKind.None || GetNativeVectorElementType(parameter.Type) != null;
+    }
+
+    private static ITypeSymbol? GetViewElementType(ITypeSymbol typeSymbol, params string[] definitions)
+    {
+        if (typeSymbol is not INamedTypeSymbol { IsGenericType: true, TypeArguments.Length: 1 } namedType)
+            return null;
+
+        if (!definitions.Contains(namedType.OriginalDefinition.ToDisplayString()))
+            return null;
+
+        var elementType = namedType.TypeArguments[0];
+        return SpanElementTypes.Contains(elementType.ToDisplayString()) ? elementType : null;
+    }
+
+    // Plugify's ValueType in declaration order, manifest type names index into it
+    private static readonly string[] ValueTypeNames =
+    [
+        "invalid", "void", "bool", "char8", "char16",
+        "int8", "int16", "int32", "int64", "uint8", "uint16", "uint32", "uint64",
+        "ptr", "float", "double", "function", "string", "any",
+        "bool[]", "char8[]", "char16[]", "int8[]", "int16[]", "int32[]", "int64[]",
+        "uint8[]", "uint16[]", "uint32[]", "uint64[]", "ptr[]", "float[]", "double[]",
+        "string[]", "any[]", "vec2[]", "vec3[]", "vec4[]", "mat4x4[]",
+        "vec2", "vec3", "vec4", "mat4x4"
+    ];
+
+    /// <summary>
+    /// Same FNV-1a hash as ExportCache::HashSignature on the native side: a ValueType byte and a ref byte for the
+    /// return type, then for every parameter.
+    /// </summary>
+    private static ulong HashSignature(PlugifyType returnType, List<MethodParameter> parameters)
+    {
+        const ulong fnvOffsetBasis = 14695981039346656037UL;
+        const ulong fnvPrime = 1099511628211UL;
+
+        ulong Hash(ulong hash, PlugifyType type, bool isRef)
+        {
+            var name = type.TypeName.Replace("ptr64", "ptr").Replace("ptr32", "ptr");
+            var valueType = Array.IndexOf(ValueTypeNames, name);
+            hash = (hash ^ (byte)Math.Max(valueType, 0)) * fnvPrime;
+            return (hash ^ (byte)(isRef ? 1 : 0)) * fnvPrime;
+        }
+
+        var signature = Hash(fnvOffsetBasis, returnType, false);
+        foreach (var parameter in parameters)
+        {
+            signature = Hash(signature, parameter.Type, parameter.IsRef);
+        }
+        return signature;
+    }
+
     private static void GenerateManifestClass(SourceProductionContext context, Compilation compilation, ImmutableArray<ExportedMethod?> methods)
     {
         var validMethods = methods.Where(m => m != null).Cast<ExportedMethod>().ToList();
@@ -388,6 +548,14 @@ public class ManifestFileGenerator : IIncrementalGenerator
                        """;
 
         context.AddSource($"PlugifyManifest.g.cs", source);
+
+        // Native entry points need pointers, so plugins built without unsafe code
+        // keep going through the reflection based invoker of the language module.
+        var stubs = validMethods.Select(m => m.Stub).OfType<ExportStub>().ToList();
+        if (stubs.Count > 0 && compilation.Options is CSharpCompilationOptions { AllowUnsafe: true })
+        {
+            context.AddSource("PlugifyExports.g.cs", ExportStubEmitter.GenerateSource(assemblyName, stubs));
+        }
     }
 
     private static object ConvertParameter(MethodParameter param, TypeTables tables)
@@ -562,6 +730,7 @@ public class ManifestFileGenerator : IIncrementalGenerator
         public string MethodName { get; set; } = "";
         public PlugifyType ReturnType { get; set; } = new();
         public List<MethodParameter> Parameters { get; set; } = [];
+        public ExportStub? Stub { get; set; }
     }
 
     private class MethodParameter
@@ -46,7 +46,7 @@ internal static class AssemblyLoader
     }
 
     [UnmanagedCallersOnly]
-    private static Guid LoadAssembly(NativeString assemblyFilePath, Bool32 shouldRemoveExtension, Bool32 isCollectible)
+    internal static Guid LoadAssembly(NativeString assemblyFilePath, Bool32 shouldRemoveExtension, Bool32 isCollectible)
     {
         try
         {
@@ -83,7 +83,7 @@ internal static class AssemblyLoader
     }
     
     [UnmanagedCallersOnly]
-    private static Bool32 UnloadAssembly(Guid assemblyId)
+    internal static Bool32 UnloadAssembly(Guid assemblyId)
     {
         try
         {
@@ -106,6 +106,10 @@ internal static class AssemblyLoader
                 {
                     var assemblyName = assembly.GetName();
 
+                    ManagedObject.RemoveCachedThunks(assembly);
+                    Timers.RemoveOwnedBy(assembly);
+                    MainThreadSynchronizationContext.Instance.RemoveOwnedBy(assembly);
+
     				if (!AllocatedHandles.TryGetValue(assemblyName, out var handles))
 					{
 						continue;
@@ -169,10 +173,10 @@ internal static class AssemblyLoader
 	}
 
 	[UnmanagedCallersOnly]
-	private static AssemblyLoadStatus GetLastLoadStatus() => LastLoadStatus;
+	internal static AssemblyLoadStatus GetLastLoadStatus() => LastLoadStatus;
 
 	[UnmanagedCallersOnly]
-	private static NativeString GetAssemblyName(Guid assemblyId)
+	internal static NativeString GetAssemblyName(Guid assemblyId)
 	{
 		if (!TryGetAssembly(assemblyId, out var wrapper))
 		{
@@ -0,0 +1,185 @@
+using System.Reflection;
+
+namespace Plugify;
+
+using static ManagedHost;
+
+/// <summary>
+/// Exports returning Task, Task&lt;T&gt;, ValueTask or ValueTask&lt;T&gt;. Their native signature returns void and takes
+/// a completion callback as last parameter, which receives the awaited result once the task finished.
+/// Awaits inside the export keep the caller's synchronization context, so a call made from the host thread
+/// also completes there.
+/// </summary>
+internal static class AsyncExports
+{
+    private delegate void Completer(object? returned, nint completion);
+
+    private static readonly MethodInfo CompleteTaskResultMethod = typeof(AsyncExports).GetMethod(nameof(CompleteTaskResult), BindingFlags.NonPublic | BindingFlags.Static)!;
+    private static readonly MethodInfo CompleteValueTaskResultMethod = typeof(AsyncExports).GetMethod(nameof(CompleteValueTaskResult), BindingFlags.NonPublic | BindingFlags.Static)!;
+
+    /// <summary>
+    /// Awaited result of a task type, typeof(void) for the non-generic ones, null when the type isn't a task.
+    /// </summary>
+    internal static Type? GetResultType(Type returnType)
+    {
+        if (returnType == typeof(Task) || returnType == typeof(ValueTask))
+            return typeof(void);
+
+        if (returnType.IsGenericType)
+        {
+            var definition = returnType.GetGenericTypeDefinition();
+            if (definition == typeof(Task<>) || definition == typeof(ValueTask<>))
+                return returnType.GetGenericArguments()[0];
+        }
+
+        return null;
+    }
+
+    internal static bool IsAsync(MethodInfo methodInfo) => GetResultType(methodInfo.ReturnType) != null;
+
+    internal static unsafe ExportThunk? CreateThunk(MethodInfo methodInfo)
+    {
+        Type resultType = GetResultType(methodInfo.ReturnType)!;
+        ParameterInfo[] parameters = methodInfo.GetParameters();
+
+        // Parameters are boxed into an argument array, so views over native memory (Span, NativeVector,
+        // NativeStringView) can't be passed
+        if (!methodInfo.IsStatic || resultType.IsByRef || (resultType != typeof(void) && resultType.ToValueType() == ValueType.Invalid)
+            || parameters.Any(p => p.ParameterType.IsByRef || p.ParameterType.IsByRefLike || p.ParameterType.ToValueType() == ValueType.Invalid))
+        {
+            return null;
+        }
+
+        bool valueTask = methodInfo.ReturnType == typeof(ValueTask) || (methodInfo.ReturnType.IsGenericType && methodInfo.ReturnType.GetGenericTypeDefinition() == typeof(ValueTask<>));
+        Completer completer = resultType == typeof(void)
+            ? valueTask ? CompleteValueTask : CompleteTask
+            : (valueTask ? CompleteValueTaskResultMethod : CompleteTaskResultMethod).MakeGenericMethod(resultType).CreateDelegate<Completer>();
+
+        var invoker = DelegateHelpers.CreateInvokeDelegate(methodInfo);
+        int parameterCount = parameters.Length;
+
+        return (parameterPtr, _) =>
+        {
+            try
+            {
+                // The completion callback follows the parameters of the method
+                nint completion = *(nint*)((byte*)parameterPtr + parameterCount * nint.Size);
+                var arguments = Marshalling.MarshalParameterArray(parameterPtr, parameterCount, methodInfo);
+                completer(invoker(null, arguments), completion);
+            }
+            catch (Exception e)
+            {
+                HandleException(e);
+            }
+        };
+    }
+
+    private static void CompleteTask(object? returned, nint completion)
+    {
+        Await((Task)returned!, GetCallback<Action>(completion));
+    }
+
+    private static void CompleteValueTask(object? returned, nint completion)
+    {
+        Await((ValueTask)returned!, GetCallback<Action>(completion));
+    }
+
+    private static void CompleteTaskResult<T>(object? returned, nint completion)
+    {
+        Await((Task<T>)returned!, GetCallback<Action<T>>(completion));
+    }
+
+    private static void CompleteValueTaskResult<T>(object? returned, nint completion)
+    {
+        Await((ValueTask<T>)returned!, GetCallback<Action<T>>(completion));
+    }
+
+    private static T? GetCallback<T>(nint completion) where T : Delegate
+    {
+        return completion != nint.Zero ? (T)Marshalling.GetCompletionDelegate(completion, typeof(T)) : null;
+    }
+
+    // A faulted task is reported through the exception callback and still completes, with the default result,
+    // so native callers waiting on it never hang
+    private static async void Await(Task task, Action? callback)
+    {
+        try
+        {
+            await task;
+        }
+        catch (Exception e)
+        {
+            HandleException(e);
+        }
+
+        Invoke(callback);
+    }
+
+    private static async void Await(ValueTask task, Action? callback)
+    {
+        try
+        {
+            await task;
+        }
+        catch (Exception e)
+        {
+            HandleException(e);
+        }
+
+        Invoke(callback);
+    }
+
+    private static async void Await<T>(Task<T> task, Action<T>? callback)
+    {
+        T result = default!;
+        try
+        {
+            result = await task;
+        }
+        catch (Exception e)
+        {
+            HandleException(e);
+        }
+
+        Invoke(callback, result);
+    }
+
+    private static async void Await<T>(ValueTask<T> task, Action<T>? callback)
+    {
+        T result = default!;
+        try
+        {
+            result = await task;
+        }
+        catch (Exception e)
+        {
+            HandleException(e);
+        }
+
+        Invoke(callback, result);
+    }
+
+    private static void Invoke(Action? callback)
+    {
+        try
+        {
+            callback?.Invoke();
+        }
+        catch (Exception e)
+        {
+            HandleException(e);
+        }
+    }
+
+    private static void Invoke<T>(Action<T>? callback, T result)
+    {
+        try
+        {
+            callback?.Invoke(result);
+        }
+        catch (Exception e)
+        {
+            HandleException(e);
+        }
+    }
+}
@@ -0,0 +1,10 @@
+namespace Plugify;
+
+/// <summary>
+/// Lets the scheduler postpone the plugin's OnPluginUpdate to a later frame once <see cref="UpdateScheduler.FrameBudget"/> is spent.
+/// The postponed update receives the time elapsed since the plugin last ran.
+/// </summary>
+[AttributeUsage(AttributeTargets.Class)]
+public class DeferrableUpdateAttribute : Attribute
+{
+}
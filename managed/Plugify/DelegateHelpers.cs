@@ -1,153 +1,562 @@
 ﻿using System.Linq.Expressions;
 using System.Reflection;
 using System.Reflection.Emit;
-using System.Text;
+using System.Runtime.InteropServices;
 
 namespace Plugify;
 
+[UnmanagedFunctionPointer(CallingConvention.Cdecl)]
+internal delegate void ExportThunk(nint parameterPtr, nint resultStorage);
+
 internal static class DelegateHelpers
 {
-    private static readonly MethodInfo FuncInvoke = typeof(Func<object?[], object?>).GetInvokeMethod();
-    private static readonly MethodInfo ArrayEmpty = typeof(Array).GetMethod(nameof(Array.Empty))!.MakeGenericMethod(typeof(object));
+    private static readonly MethodInfo GetTypeFromHandle = typeof(Type).GetMethod(nameof(Type.GetTypeFromHandle))!;
+    private static readonly MethodInfo GetDelegateForFunctionPointer = typeof(Marshalling).GetMethod(nameof(Marshalling.GetDelegateForFunctionPointer), [typeof(nint), typeof(Type)])!;
+    private static readonly MethodInfo GetFunctionPointer = typeof(DelegateHelpers).GetMethod(nameof(GetFunctionPointerOrZero), BindingFlags.NonPublic | BindingFlags.Static)!;
+    private static readonly MethodInfo HandleException = typeof(ManagedHost).GetMethod(nameof(ManagedHost.HandleException))!;
 
-    // https://github.com/mono/corefx/blob/main/src/System.Linq.Expressions/src/System/Dynamic/Utils/DelegateHelpers.cs
-    // We will generate the following code:
+    // Signature-specialized export thunk. We will generate the following code:
     //
-    // object ret;
-    // object[] args = new object[parameterCount];
-    // args[0] = param0;
-    // args[1] = param1;
-    //  ...
     // try {
-    //      ret = handler.Invoke(args);
-    // } finally {
-    //      param0 = (T0)args[0]; // only generated for each byref argument
+    //      T0 arg0 = *(T0*)params[0];                       // value types are read in place
+    //      T1 arg1 = NativeMethods.GetStringData(params[1]); // objects go through typed natives
+    //      Span<T3> arg3 = NativeMethods.GetVectorSpanFloat(params[3]); // blittable spans view the vector in place
+    //      NativeVector<T4> arg4 = new NativeVector<T4>(params[4]); // and native vectors edit it in place
+    //      NativeStringView arg5 = new NativeStringView(params[5]); // string views decode nothing up front
+    //      TRet ret = Method(arg0, ref *(T2*)params[2], ref arg1, ...);
+    //      if (arg1 == null) throw new Exception("Reference cannot be null");
+    //      NativeMethods.AssignString(params[1], arg1);      // only generated for each byref object argument
+    //      *(TRet*)result = ret;
+    // } catch (Exception e) {
+    //      ManagedHost.HandleException(e);
     // }
-    // return (TRet)ret;
-    public static Delegate CreateObjectArrayDelegate(Type delegateType, Func<object?[], object?> handler, string name = "")
+    //
+    // Unlike the reflection invoker nothing is boxed and no object[] is allocated.
+    public static ExportThunk? CreateExportThunk(MethodInfo methodInfo)
     {
-        MethodInfo delegateInvokeMethod = delegateType.GetInvokeMethod();
+        if (AsyncExports.IsAsync(methodInfo))
+        {
+            return AsyncExports.CreateThunk(methodInfo);
+        }
 
-        Type returnType = delegateInvokeMethod.ReturnType;
-        bool hasReturnValue = returnType != typeof(void);
+        ParameterInfo[] parameters = methodInfo.GetParameters();
+        Type returnType = methodInfo.ReturnType;
 
-        StringBuilder thunkName = new StringBuilder();
-        thunkName.Append("Thunk_");
-        thunkName.Append(name);
-        if (hasReturnValue)
+        if (!methodInfo.IsStatic || returnType.ToValueType() == ValueType.Invalid || returnType.GetSpanElementType() != null || returnType.GetNativeVectorElementType() != null || returnType == typeof(NativeStringView) || parameters.Any(p => p.ParameterType.ToValueType() == ValueType.Invalid))
         {
-            thunkName.Append("_ret_");
-            thunkName.Append(returnType.Name);
+            return null;
         }
 
-        ParameterInfo[] parameters = delegateInvokeMethod.GetParameters();
-        Type[] paramTypes = new Type[parameters.Length + 1];
-        paramTypes[0] = typeof(Func<object?[], object?>);
+        DynamicMethod thunkMethod = new DynamicMethod("ExportThunk_" + methodInfo.Name, typeof(void), [typeof(nint), typeof(nint)], methodInfo.DeclaringType!.Module, skipVisibility: true);
+        ILGenerator il = thunkMethod.GetILGenerator();
+
+        LocalBuilder?[] locals = new LocalBuilder?[parameters.Length];
+
+        il.BeginExceptionBlock();
 
         for (int i = 0; i < parameters.Length; i++)
         {
             Type paramType = parameters[i].ParameterType;
-            thunkName.Append('_');
-            thunkName.Append(paramType.Name);
-            paramTypes[i + 1] = paramType;
+            bool paramIsByReference = paramType.IsByRef;
+            Type elementType = paramIsByReference ? paramType.GetElementType()! : paramType;
+            ValueType valueType = paramType.ToValueType();
+
+            EmitLoadParameterPointer(il, i);
+
+            if (valueType == ValueType.Function)
+            {
+                // function pointers are passed by value, unless it is a reference
+                if (paramIsByReference)
+                {
+                    il.Emit(OpCodes.Ldind_I);
+                }
+                il.Emit(OpCodes.Ldtoken, elementType);
+                il.Emit(OpCodes.Call, GetTypeFromHandle);
+                il.Emit(OpCodes.Call, GetDelegateForFunctionPointer);
+                il.Emit(OpCodes.Castclass, elementType);
+            }
+            else if (elementType.GetSpanElementType() is { } spanElementType)
+            {
+                // spans are never by reference, they view the vector for the duration of the call
+                il.Emit(OpCodes.Call, FindVectorNative("GetVectorSpan", valueType, spanElementType, static _ => true));
+                if (elementType.GetGenericTypeDefinition() == typeof(ReadOnlySpan<>))
+                {
+                    Type spanType = typeof(Span<>).MakeGenericType(spanElementType);
+                    il.Emit(OpCodes.Call, spanType.GetMethod("op_Implicit", [spanType])!);
+                }
+                continue;
+            }
+            else if (elementType.GetNativeVectorElementType() != null || elementType == typeof(NativeStringView))
+            {
+                // wraps the caller's vector or string, resizes and writes through a vector need no copy back
+                il.Emit(OpCodes.Newobj, elementType.GetConstructor(BindingFlags.NonPublic | BindingFlags.Instance, [typeof(nint)])!);
+                continue;
+            }
+            else if (valueType is >= ValueType._ObjectStart and <= ValueType._ObjectEnd)
+            {
+                il.Emit(OpCodes.Call, GetObjectReader(valueType, elementType));
+            }
+            else
+            {
+                // by reference value types are handed out as the native address itself
+                if (!paramIsByReference)
+                {
+                    il.Emit(OpCodes.Ldobj, elementType);
+                }
+                continue;
+            }
+
+            if (paramIsByReference)
+            {
+                LocalBuilder local = il.DeclareLocal(elementType);
+                il.Emit(OpCodes.Stloc, local);
+                il.Emit(OpCodes.Ldloca, local);
+                locals[i] = local;
+            }
+        }
+
+        il.EmitCall(OpCodes.Call, methodInfo, null);
+
+        LocalBuilder? retValue = returnType != typeof(void) ? il.DeclareLocal(returnType) : null;
+        if (retValue != null)
+        {
+            il.Emit(OpCodes.Stloc, retValue);
+        }
+
+        for (int i = 0; i < parameters.Length; i++)
+        {
+            LocalBuilder? local = locals[i];
+            if (local != null)
+            {
+                ValueType valueType = parameters[i].ParameterType.ToValueType();
+                if (valueType is >= ValueType._ObjectStart and <= ValueType._ObjectEnd)
+                {
+                    // same as the reflection invoker, which refuses to store a null reference back
+                    EmitThrowIfNull(il, local, "Reference cannot be null");
+                }
+                EmitStoreValue(il, gen => EmitLoadParameterPointer(gen, i), local, valueType);
+            }
+        }
+
+        if (retValue != null)
+        {
+            EmitStoreValue(il, gen => gen.Emit(OpCodes.Ldarg_1), retValue, returnType.ToValueType());
         }
 
-        DynamicMethod thunkMethod = new DynamicMethod(thunkName.ToString(), returnType, paramTypes);
-        ILGenerator ilgen = thunkMethod.GetILGenerator();
+        il.BeginCatchBlock(typeof(Exception));
+        il.Emit(OpCodes.Call, HandleException);
+        il.EndExceptionBlock();
 
-        LocalBuilder argArray = ilgen.DeclareLocal(typeof(object[]));
-        LocalBuilder retValue = ilgen.DeclareLocal(typeof(object));
+        il.Emit(OpCodes.Ret);
+
+        return (ExportThunk)thunkMethod.CreateDelegate(typeof(ExportThunk));
+    }
 
-        // create the argument array
-        if (parameters.Length == 0)
+    private static void EmitLoadParameterPointer(ILGenerator il, int index)
+    {
+        // params is stored as void**
+        il.Emit(OpCodes.Ldarg_0);
+        if (index != 0)
         {
-            ilgen.Emit(OpCodes.Call, ArrayEmpty);
+            EmitFastInt(il, index * IntPtr.Size);
+            il.Emit(OpCodes.Add);
+        }
+        il.Emit(OpCodes.Ldind_I);
+    }
+
+    private static void EmitThrowIfNull(ILGenerator il, LocalBuilder value, string message)
+    {
+        Label notNull = il.DefineLabel();
+        il.Emit(OpCodes.Ldloc, value);
+        il.Emit(OpCodes.Brtrue, notNull);
+        il.Emit(OpCodes.Ldstr, message);
+        il.Emit(OpCodes.Newobj, typeof(Exception).GetConstructor([typeof(string)])!);
+        il.Emit(OpCodes.Throw);
+        il.MarkLabel(notNull);
+    }
+
+    private static void EmitStoreValue(ILGenerator il, Action<ILGenerator> loadAddress, LocalBuilder value, ValueType valueType)
+    {
+        Type type = value.LocalType;
+
+        if (valueType == ValueType.Function)
+        {
+            loadAddress(il);
+            il.Emit(OpCodes.Ldloc, value);
+            il.Emit(OpCodes.Call, GetFunctionPointer);
+            il.Emit(OpCodes.Stind_I);
+        }
+        else if (valueType is >= ValueType._ObjectStart and <= ValueType._ObjectEnd)
+        {
+            // null object returns leave the native storage untouched, except for variant which supports it
+            Label skip = il.DefineLabel();
+            if (valueType != ValueType.Any)
+            {
+                il.Emit(OpCodes.Ldloc, value);
+                il.Emit(OpCodes.Brfalse, skip);
+            }
+            loadAddress(il);
+            il.Emit(OpCodes.Ldloc, value);
+            il.Emit(OpCodes.Call, GetObjectWriter(valueType, type));
+            il.MarkLabel(skip);
         }
         else
         {
-            ilgen.Emit(OpCodes.Ldc_I4, parameters.Length);
-            ilgen.Emit(OpCodes.Newarr, typeof(object));
+            loadAddress(il);
+            il.Emit(OpCodes.Ldloc, value);
+            il.Emit(OpCodes.Stobj, type);
+        }
+    }
+
+    private static MethodInfo GetObjectReader(ValueType valueType, Type type)
+    {
+        return valueType switch
+        {
+            ValueType.String => FindNative(typeof(NativeMethods), nameof(NativeMethods.GetStringData), static m => m.GetParameters().Length == 1),
+            ValueType.Any => FindNative(typeof(NativeMethods), nameof(NativeMethods.GetVariantData), static m => m.GetParameters().Length == 1),
+            _ => FindVectorNative("GetVectorData", valueType, type, static m => m.GetParameters().Length == 1 && m.ReturnType.IsArray)
+        };
+    }
+
+    private static MethodInfo GetObjectWriter(ValueType valueType, Type type)
+    {
+        return valueType switch
+        {
+            ValueType.String => FindNative(typeof(NativeMethods), nameof(NativeMethods.AssignString), static m => m.GetParameters().Length == 2),
+            ValueType.Any => FindNative(typeof(NativeMethods), nameof(NativeMethods.AssignVariant), static m => m.GetParameters().Length == 2),
+            _ => FindVectorNative("AssignVector", valueType, type, static m => m.GetParameters() is { Length: 2 } p && p[1].ParameterType.IsArray)
+        };
+    }
+
+    private static MethodInfo FindVectorNative(string prefix, ValueType valueType, Type type, Func<MethodInfo, bool> predicate)
+    {
+        string suffix = valueType switch
+        {
+            ValueType.ArrayPointer => "IntPtr",
+            ValueType.ArrayAny => "Variant",
+            _ => valueType.ToString()["Array".Length..]
+        };
+
+        Type? enumType = type.GetEnumType();
+        if (enumType != null)
+        {
+            return FindNative(typeof(NativeMethodsT), prefix + suffix, predicate).MakeGenericMethod(enumType);
+        }
+
+        return FindNative(typeof(NativeMethods), prefix + suffix, predicate);
+    }
+
+    private static MethodInfo FindNative(Type owner, string name, Func<MethodInfo, bool> predicate)
+    {
+        return owner
+            .GetMethods(BindingFlags.Public | BindingFlags.Static)
+            .First(m => m.Name == name && predicate(m));
+    }
+
+    private static nint GetFunctionPointerOrZero(Delegate? d)
+    {
+        return d != null ? Marshalling.GetFunctionPointerForDelegate(d) : nint.Zero;
+    }
+
+    // Signature-specialized native call. We will generate the following code:
+    //
+    // ulong* params = stackalloc ulong[count];
+    // ulong* ret = stackalloc ulong[2]; // 128bits to fit Vector4
+    // int live = 0;
+    // try {
+    //      params[0] = &hidden;                                 // only for returns passed through a hidden pointer
+    //      *(T0*)&params[1] = arg0;                             // value types are stored in place
+    //      String192 str0 = NativeMethods.ConstructString(arg1); live = 1;
+    //      params[2] = &str0;
+    //      params[3] = &pinned(arg2);                           // byref value types are pinned, not copied
+    //      function(params, ret);
+    //      live = 2;                                            // hidden object return is constructed by the callee
+    //      arg1 = NativeMethods.GetStringData(&str0);           // only generated for each byref object argument
+    //      result = NativeMethods.GetStringData(&hidden);
+    // } finally {
+    //      if (live > 1) NativeMethods.DestroyString(&hidden);
+    //      if (live > 0) NativeMethods.DestroyString(&str0);
+    // }
+    // return result;
+    //
+    // The layout is resolved once per signature, so a call boxes nothing and allocates nothing on the managed heap.
+    public static Delegate CreateExternalInvoker(Type delegateType, JitCall jit, nint function, bool hasHiddenReturn, string name = "")
+    {
+        MethodInfo delegateInvokeMethod = delegateType.GetInvokeMethod();
+        ParameterInfo[] parameters = delegateInvokeMethod.GetParameters();
+        Type returnType = delegateInvokeMethod.ReturnType;
+
+        // ToValueType maps views to the array or string they stand for, an invoker would build a vector over a ref struct
+        if (returnType.IsViewType() || parameters.Any(p => p.ParameterType.IsViewType()))
+        {
+            throw new NotSupportedException($"Delegate {delegateType.Name} cannot call native code, Span<T>, NativeVector<T> and NativeStringView are only supported as export parameters.");
         }
-        ilgen.Emit(OpCodes.Stloc, argArray);
 
-        // populate object array
-        bool hasRefArgs = false;
+        ValueType retType = returnType.ToValueType();
+
+        Type[] paramTypes = new Type[parameters.Length + 1];
+        paramTypes[0] = typeof(JitCall);
         for (int i = 0; i < parameters.Length; i++)
+        {
+            paramTypes[i + 1] = parameters[i].ParameterType;
+        }
+
+        DynamicMethod invokerMethod = new DynamicMethod("Invoker_" + name, returnType, paramTypes, typeof(JitCall).Module, skipVisibility: true);
+        ILGenerator il = invokerMethod.GetILGenerator();
+
+        int slotCount = parameters.Length + (hasHiddenReturn ? 1 : 0);
+
+        LocalBuilder paramsPtr = il.DeclareLocal(typeof(ulong*));
+        LocalBuilder retPtr = il.DeclareLocal(typeof(ulong*));
+        LocalBuilder live = il.DeclareLocal(typeof(int));
+        LocalBuilder? result = returnType != typeof(void) ? il.DeclareLocal(returnType) : null;
+
+        EmitFastInt(il, Math.Max(slotCount, 1) * sizeof(ulong));
+        il.Emit(OpCodes.Conv_U);
+        il.Emit(OpCodes.Localloc);
+        il.Emit(OpCodes.Stloc, paramsPtr);
+
+        EmitFastInt(il, 2 * sizeof(ulong));
+        il.Emit(OpCodes.Conv_U);
+        il.Emit(OpCodes.Localloc);
+        il.Emit(OpCodes.Stloc, retPtr);
+
+        // objects which have to be destroyed, in construction order
+        List<(LocalBuilder Storage, MethodInfo Destroy)> cleanup = [];
+        LocalBuilder?[] storages = new LocalBuilder?[parameters.Length];
+
+        bool hasObjects = IsObject(retType) || parameters.Any(p => IsObject(p.ParameterType.ToValueType()));
+        if (hasObjects)
+        {
+            il.BeginExceptionBlock();
+        }
+
+        int slot = 0;
+
+        LocalBuilder? hidden = null;
+        if (hasHiddenReturn)
+        {
+            hidden = il.DeclareLocal(IsObject(retType) ? GetStorageType(retType) : returnType);
+            EmitLoadSlot(il, paramsPtr, slot++);
+            il.Emit(OpCodes.Ldloca, hidden);
+            il.Emit(OpCodes.Conv_U);
+            il.Emit(OpCodes.Stind_I);
+        }
+
+        for (int i = 0; i < parameters.Length; i++, slot++)
         {
             Type paramType = parameters[i].ParameterType;
             bool paramIsByReference = paramType.IsByRef;
-            if (paramIsByReference)
+            Type elementType = paramIsByReference ? paramType.GetElementType()! : paramType;
+            ValueType valueType = paramType.ToValueType();
+
+            if (valueType == ValueType.Function)
             {
-                paramType = paramType.GetElementType()!;
+                EmitLoadSlot(il, paramsPtr, slot);
+                il.Emit(OpCodes.Ldarg, i + 1);
+                if (paramIsByReference)
+                {
+                    il.Emit(OpCodes.Ldind_Ref);
+                }
+                il.Emit(OpCodes.Call, GetFunctionPointer);
+                il.Emit(OpCodes.Stind_I);
             }
+            else if (IsObject(valueType))
+            {
+                LocalBuilder storage = il.DeclareLocal(GetStorageType(valueType));
+                il.Emit(OpCodes.Ldarg, i + 1);
+                if (paramIsByReference)
+                {
+                    il.Emit(OpCodes.Ldind_Ref);
+                }
+                EmitConstructObject(il, valueType, elementType);
+                il.Emit(OpCodes.Stloc, storage);
 
-            hasRefArgs = hasRefArgs || paramIsByReference;
+                cleanup.Add((storage, GetObjectDestructor(valueType)));
+                EmitFastInt(il, cleanup.Count);
+                il.Emit(OpCodes.Stloc, live);
 
-            ilgen.Emit(OpCodes.Ldloc, argArray);
-            ilgen.Emit(OpCodes.Ldc_I4, i);
-            ilgen.Emit(OpCodes.Ldarg, i + 1);
+                EmitLoadSlot(il, paramsPtr, slot);
+                il.Emit(OpCodes.Ldloca, storage);
+                il.Emit(OpCodes.Conv_U);
+                il.Emit(OpCodes.Stind_I);
 
-            if (paramIsByReference)
+                if (paramIsByReference)
+                {
+                    storages[i] = storage;
+                }
+            }
+            else if (paramIsByReference)
+            {
+                // native side writes straight into the caller's variable
+                LocalBuilder pinned = il.DeclareLocal(paramType, pinned: true);
+                il.Emit(OpCodes.Ldarg, i + 1);
+                il.Emit(OpCodes.Stloc, pinned);
+                EmitLoadSlot(il, paramsPtr, slot);
+                il.Emit(OpCodes.Ldloc, pinned);
+                il.Emit(OpCodes.Conv_U);
+                il.Emit(OpCodes.Stind_I);
+            }
+            else if (valueType is >= ValueType._StructStart and <= ValueType._StructEnd)
             {
-                ilgen.Emit(OpCodes.Ldobj, paramType);
+                // structs are passed by pointer, the argument itself lives on the stack
+                EmitLoadSlot(il, paramsPtr, slot);
+                il.Emit(OpCodes.Ldarga, i + 1);
+                il.Emit(OpCodes.Conv_U);
+                il.Emit(OpCodes.Stind_I);
+            }
+            else
+            {
+                EmitLoadSlot(il, paramsPtr, slot);
+                il.Emit(OpCodes.Ldarg, i + 1);
+                il.Emit(OpCodes.Stobj, elementType);
             }
-            Type boxType = ConvertToBoxableType(paramType);
-            ilgen.Emit(OpCodes.Box, boxType);
-            ilgen.Emit(OpCodes.Stelem_Ref);
         }
 
-        if (hasRefArgs)
+        il.Emit(OpCodes.Ldloc, paramsPtr);
+        il.Emit(OpCodes.Ldloc, retPtr);
+        il.Emit(OpCodes.Ldc_I8, (long)function);
+        il.Emit(OpCodes.Conv_I);
+        il.EmitCalli(OpCodes.Calli, CallingConvention.Cdecl, typeof(void), [typeof(ulong*), typeof(ulong*)]);
+
+        if (hidden != null && IsObject(retType))
         {
-            ilgen.BeginExceptionBlock();
+            cleanup.Add((hidden, GetObjectDestructor(retType)));
+            EmitFastInt(il, cleanup.Count);
+            il.Emit(OpCodes.Stloc, live);
         }
 
-        // load delegate
-        ilgen.Emit(OpCodes.Ldarg_0);
-
-        // load array
-        ilgen.Emit(OpCodes.Ldloc, argArray);
-
-        // invoke Invoke
-        ilgen.Emit(OpCodes.Callvirt, FuncInvoke);
-        ilgen.Emit(OpCodes.Stloc, retValue);
+        // copy back ref/out objects
+        for (int i = 0; i < parameters.Length; i++)
+        {
+            LocalBuilder? storage = storages[i];
+            if (storage != null)
+            {
+                Type elementType = parameters[i].ParameterType.GetElementType()!;
+                il.Emit(OpCodes.Ldarg, i + 1);
+                il.Emit(OpCodes.Ldloca, storage);
+                il.Emit(OpCodes.Conv_U);
+                il.Emit(OpCodes.Call, GetObjectReader(parameters[i].ParameterType.ToValueType(), elementType));
+                il.Emit(OpCodes.Stobj, elementType);
+            }
+        }
 
-        if (hasRefArgs)
+        if (result != null)
         {
-            // copy back ref/out args
-            ilgen.BeginFinallyBlock();
-            for (int i = 0; i < parameters.Length; i++)
+            if (hidden != null)
             {
-                var paramType = parameters[i].ParameterType;
-                if (paramType.IsByRef)
+                if (IsObject(retType))
                 {
-                    Type byrefToType = paramType.GetElementType()!;
-
-                    // update parameter
-                    ilgen.Emit(OpCodes.Ldarg, i + 1);
-                    ilgen.Emit(OpCodes.Ldloc, argArray);
-                    ilgen.Emit(OpCodes.Ldc_I4, i);
-                    ilgen.Emit(OpCodes.Ldelem_Ref);
-                    ilgen.Emit(OpCodes.Unbox_Any, byrefToType);
-                    ilgen.Emit(OpCodes.Stobj, byrefToType);
+                    il.Emit(OpCodes.Ldloca, hidden);
+                    il.Emit(OpCodes.Conv_U);
+                    il.Emit(OpCodes.Call, GetObjectReader(retType, returnType));
                 }
+                else
+                {
+                    il.Emit(OpCodes.Ldloc, hidden);
+                }
+            }
+            else if (retType == ValueType.Function)
+            {
+                il.Emit(OpCodes.Ldloc, retPtr);
+                il.Emit(OpCodes.Ldind_I);
+                il.Emit(OpCodes.Ldtoken, returnType);
+                il.Emit(OpCodes.Call, GetTypeFromHandle);
+                il.Emit(OpCodes.Call, GetDelegateForFunctionPointer);
+                il.Emit(OpCodes.Castclass, returnType);
+            }
+            else
+            {
+                il.Emit(OpCodes.Ldloc, retPtr);
+                il.Emit(OpCodes.Ldobj, returnType);
             }
-            ilgen.EndExceptionBlock();
+            il.Emit(OpCodes.Stloc, result);
         }
 
-        if (hasReturnValue)
+        if (hasObjects)
         {
-            ilgen.Emit(OpCodes.Ldloc, retValue);
-            ilgen.Emit(OpCodes.Unbox_Any, ConvertToBoxableType(returnType));
+            il.BeginFinallyBlock();
+            for (int k = cleanup.Count - 1; k >= 0; k--)
+            {
+                Label skip = il.DefineLabel();
+                il.Emit(OpCodes.Ldloc, live);
+                EmitFastInt(il, k);
+                il.Emit(OpCodes.Ble, skip);
+                il.Emit(OpCodes.Ldloca, cleanup[k].Storage);
+                il.Emit(OpCodes.Conv_U);
+                il.Emit(OpCodes.Call, cleanup[k].Destroy);
+                il.MarkLabel(skip);
+            }
+            il.EndExceptionBlock();
         }
 
-        ilgen.Emit(OpCodes.Ret);
+        if (result != null)
+        {
+            il.Emit(OpCodes.Ldloc, result);
+        }
+        il.Emit(OpCodes.Ret);
 
-        return thunkMethod.CreateDelegate(delegateType, handler);
+        return invokerMethod.CreateDelegate(delegateType, jit);
     }
 
-    private static Type ConvertToBoxableType(Type type)
+    private static bool IsObject(ValueType valueType) => valueType is >= ValueType._ObjectStart and <= ValueType._ObjectEnd;
+
+    private static Type GetStorageType(ValueType valueType)
+    {
+        return valueType switch
+        {
+            ValueType.String => typeof(String192),
+            ValueType.Any => typeof(Variant256),
+            _ => typeof(Vector192)
+        };
+    }
+
+    private static void EmitLoadSlot(ILGenerator il, LocalBuilder paramsPtr, int slot)
+    {
+        il.Emit(OpCodes.Ldloc, paramsPtr);
+        if (slot != 0)
+        {
+            EmitFastInt(il, slot * sizeof(ulong));
+            il.Emit(OpCodes.Add);
+        }
+    }
+
+    private static void EmitConstructObject(ILGenerator il, ValueType valueType, Type type)
+    {
+        switch (valueType)
+        {
+            case ValueType.String:
+                il.Emit(OpCodes.Call, FindNative(typeof(NativeMethods), nameof(NativeMethods.ConstructString), static m => m.GetParameters().Length == 1));
+                return;
+            case ValueType.Any:
+                il.Emit(OpCodes.Call, FindNative(typeof(NativeMethods), nameof(NativeMethods.ConstructVariant), static m => m.GetParameters().Length == 1));
+                return;
+        }
+
+        if (type.GetEnumType() != null)
+        {
+            // enum arrays only have the (arr, len) overload
+            LocalBuilder array = il.DeclareLocal(type);
+            il.Emit(OpCodes.Stloc, array);
+            il.Emit(OpCodes.Ldloc, array);
+            il.Emit(OpCodes.Ldloc, array);
+            il.Emit(OpCodes.Ldlen);
+            il.Emit(OpCodes.Conv_I4);
+            il.Emit(OpCodes.Call, FindVectorNative("ConstructVector", valueType, type, static m => m.GetParameters().Length == 2));
+            return;
+        }
+
+        il.Emit(OpCodes.Call, FindVectorNative("ConstructVector", valueType, type, static m => m.GetParameters() is { Length: 1 } p && p[0].ParameterType.IsArray));
+    }
+
+    private static MethodInfo GetObjectDestructor(ValueType valueType)
     {
-        return type.IsPointer ? typeof(nint) : type;
+        return valueType switch
+        {
+            ValueType.String => FindNative(typeof(NativeMethods), nameof(NativeMethods.DestroyString), static _ => true),
+            ValueType.Any => FindNative(typeof(NativeMethods), nameof(NativeMethods.DestroyVariant), static _ => true),
+            _ => FindVectorNative("DestroyVector", valueType, typeof(object), static _ => true)
+        };
     }
 
     // https://www.codeproject.com/articles/A-General-Fast-Method-Invoker#comments-section
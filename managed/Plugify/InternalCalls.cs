@@ -1,5 +1,7 @@
-using System.Runtime.InteropServices;
 using System.Reflection;
+using System.Reflection.Emit;
+using System.Runtime.CompilerServices;
+using System.Runtime.InteropServices;
 
 namespace Plugify.Interop;
 
@@ -8,62 +10,161 @@ using static ManagedHost;
 [StructLayout(LayoutKind.Sequential, Pack = 1)]
 internal readonly struct InternalCall
 {
-    private readonly nint namePtr;
+    private readonly nint typeNamePtr;
+    private readonly nint fieldNamePtr;
     public readonly nint NativeFunctionPtr;
 
-    public string? Name => Marshal.PtrToStringAuto(namePtr);
+    public string? TypeName => Marshal.PtrToStringAuto(typeNamePtr);
+    public string? FieldName => Marshal.PtrToStringAuto(fieldNamePtr);
 }
 
 internal static class InternalCallsManager
 {
+    private unsafe delegate void FieldSetter(nint* values);
+
+    // Function pointer fields of a binding class, indexed once per type. All of them are written
+    // by a single compiled setter instead of a reflective FieldInfo.SetValue per field.
+    private sealed class FieldIndex
+    {
+        public const int NotFunctionPointer = -1;
+
+        public readonly Dictionary<string, int> Slots = new();
+        public readonly int Count;
+        public readonly FieldSetter Setter;
+
+        public FieldIndex(Type type)
+        {
+            var fields = type.GetFields(BindingFlags.Static | BindingFlags.NonPublic);
+            var targets = new List<FieldInfo>(fields.Length);
+
+            foreach (var field in fields)
+            {
+                if (!field.FieldType.IsFunctionPointer || field.IsInitOnly)
+                {
+                    Slots.TryAdd(field.Name, NotFunctionPointer);
+                    continue;
+                }
+
+                if (Slots.TryAdd(field.Name, targets.Count))
+                {
+                    targets.Add(field);
+                }
+            }
+
+            Count = targets.Count;
+            Setter = CreateSetter(type, targets);
+        }
+
+        // values[i] is stored into the i-th field, zero entries leave the field untouched
+        private static FieldSetter CreateSetter(Type type, List<FieldInfo> targets)
+        {
+            DynamicMethod setterMethod = new DynamicMethod("InternalCallSetter_" + type.Name, typeof(void), [typeof(nint*)], type.Module, skipVisibility: true);
+            ILGenerator il = setterMethod.GetILGenerator();
+            LocalBuilder value = il.DeclareLocal(typeof(nint));
+
+            for (int i = 0; i < targets.Count; i++)
+            {
+                Label skip = il.DefineLabel();
+
+                il.Emit(OpCodes.Ldarg_0);
+                if (i != 0)
+                {
+                    il.Emit(OpCodes.Ldc_I4, i * IntPtr.Size);
+                    il.Emit(OpCodes.Add);
+                }
+                il.Emit(OpCodes.Ldind_I);
+                il.Emit(OpCodes.Stloc, value);
+                il.Emit(OpCodes.Ldloc, value);
+                il.Emit(OpCodes.Brfalse, skip);
+                il.Emit(OpCodes.Ldloc, value);
+                il.Emit(OpCodes.Stsfld, targets[i]);
+                il.MarkLabel(skip);
+            }
+
+            il.Emit(OpCodes.Ret);
+
+            return setterMethod.CreateDelegate<FieldSetter>();
+        }
+    }
+
+    private static readonly ConditionalWeakTable<Type, FieldIndex> FieldIndices = new();
+
     [UnmanagedCallersOnly]
-    private static unsafe void SetInternalCalls(InternalCall* internalCallsArrayPtr, int length, Bool32 warnOnMissing)
+    internal static unsafe void SetInternalCalls(Guid assemblyId, InternalCall* internalCallsArrayPtr, int length, Bool32 warnOnMissing)
     {
         try
         {
+            if (!AssemblyLoader.TryGetAssembly(assemblyId, out var wrapper) || !wrapper.Assembly.TryGetTarget(out var assembly))
+            {
+                LogMessage($"Cannot register internal calls, assembly '{assemblyId}' not found.", MessageLevel.Error);
+                return;
+            }
+
+            // Calls come grouped by binding class, each class is resolved and written once
+            var batches = new Dictionary<string, (FieldIndex? Index, nint[]? Values)>();
+
             for (int i = 0; i < length; i++)
             {
                 var internalCall = internalCallsArrayPtr[i];
-                var name = internalCall.Name;
+                var typeName = internalCall.TypeName;
+                var fieldName = internalCall.FieldName;
 
-                if (name == null)
+                if (typeName == null || fieldName == null)
                 {
                     LogMessage($"Cannot register internal at index '{i}' call with null name!", MessageLevel.Error);
                     continue;
                 }
 
-                var fieldNameStart = name.IndexOf('@');
-                var fieldNameEnd = name.IndexOf(",", fieldNameStart, StringComparison.CurrentCulture);
-                var fieldName = name.Substring(fieldNameStart + 1, fieldNameEnd - fieldNameStart - 1);
-                var containingTypeName = name.Remove(fieldNameStart, fieldNameEnd - fieldNameStart);
-
-                var type = TypeInterface.FindType(containingTypeName);
-                
-                if (type == null)
+                if (!batches.TryGetValue(typeName, out var batch))
                 {
-                    if (warnOnMissing)
+                    var type = assembly.GetType(typeName);
+                    if (type == null)
+                    {
+                        if (warnOnMissing)
+                        {
+                            LogMessage($"Cannot register internal call '{typeName}@{fieldName}', failed to find type '{typeName}' in '{assembly.FullName}'.", MessageLevel.Error);
+                        }
+                    }
+                    else
                     {
-                        LogMessage($"Cannot register internal call '{name}', failed to type '{containingTypeName}'.", MessageLevel.Error);
+                        var index = FieldIndices.GetValue(type, static t => new FieldIndex(t));
+                        batch = (index, new nint[index.Count]);
                     }
+
+                    batches.Add(typeName, batch);
+                }
+
+                if (batch.Index == null)
+                {
                     continue;
                 }
 
-                var bindingFlags = BindingFlags.Static | BindingFlags.NonPublic;
-                var field = type.GetFields(bindingFlags).FirstOrDefault(field => field.Name == fieldName);
+                if (!batch.Index.Slots.TryGetValue(fieldName, out var slot))
+                {
+                    LogMessage($"Cannot register internal '{typeName}@{fieldName}', failed to find it in type '{typeName}'", MessageLevel.Error);
+                    continue;
+                }
 
-                if (field == null)
+                if (slot == FieldIndex.NotFunctionPointer)
                 {
-                    LogMessage($"Cannot register internal '{name}', failed to find it in type '{containingTypeName}'", MessageLevel.Error);
+                    LogMessage($"Field '{typeName}@{fieldName}' is not a function pointer type!", MessageLevel.Error);
                     continue;
                 }
 
-                if (!field.FieldType.IsFunctionPointer)
+                batch.Values![slot] = internalCall.NativeFunctionPtr;
+            }
+
+            foreach (var (index, values) in batches.Values)
+            {
+                if (index == null)
                 {
-                    LogMessage($"Field '{name}' is not a function pointer type!", MessageLevel.Error);
                     continue;
                 }
 
-                field.SetValue(null, internalCall.NativeFunctionPtr);
+                fixed (nint* valuesPtr = values)
+                {
+                    index.Setter(valuesPtr);
+                }
             }
         }
         catch (Exception e)
@@ -0,0 +1,231 @@
+using System.Diagnostics;
+using System.Reflection;
+using System.Runtime.ExceptionServices;
+
+namespace Plugify;
+
+using static ManagedHost;
+
+/// <summary>
+/// Synchronization context of the host thread, installed when the module initializes. Awaits started there
+/// resume there as well, once per frame during the module's update, within <see cref="UpdateScheduler.ContinuationBudget"/>.
+/// </summary>
+public sealed class MainThreadSynchronizationContext : SynchronizationContext
+{
+    private struct WorkItem
+    {
+        public SendOrPostCallback Callback;
+        public object? State;
+        public PendingSend? Send; // set when a thread blocks in Send until the item ran or was dropped
+    }
+
+    private sealed class PendingSend
+    {
+        public readonly ManualResetEventSlim Done = new();
+        public ExceptionDispatchInfo? Error;
+
+        public void Fail(string message)
+        {
+            Error = ExceptionDispatchInfo.Capture(new OperationCanceledException(message));
+            Done.Set();
+        }
+    }
+
+    public static MainThreadSynchronizationContext Instance { get; } = new();
+
+    private readonly object _lock = new();
+    private WorkItem[] _items = new WorkItem[64];
+    private int _head;
+    private int _count;
+    private int _threadId = -1;
+
+    private MainThreadSynchronizationContext()
+    {
+    }
+
+    /// <summary>
+    /// Whether the calling thread is the host thread the continuations run on.
+    /// </summary>
+    public bool IsMainThread => Environment.CurrentManagedThreadId == _threadId;
+
+    public override SynchronizationContext CreateCopy() => this;
+
+    public override void Post(SendOrPostCallback d, object? state)
+    {
+        ArgumentNullException.ThrowIfNull(d);
+
+        lock (_lock)
+        {
+            Enqueue(new WorkItem { Callback = d, State = state });
+        }
+    }
+
+    public override void Send(SendOrPostCallback d, object? state)
+    {
+        ArgumentNullException.ThrowIfNull(d);
+
+        if (IsMainThread)
+        {
+            d(state);
+            return;
+        }
+
+        // Blocks until the next pump of the host thread has run the callback, or until the item is dropped
+        var send = new PendingSend();
+        lock (_lock)
+        {
+            if (_threadId == -1)
+                throw new InvalidOperationException("The host thread synchronization context is not installed.");
+
+            Enqueue(new WorkItem { Callback = d, State = state, Send = send });
+        }
+
+        send.Done.Wait();
+        send.Done.Dispose();
+        send.Error?.Throw();
+    }
+
+    internal void Install()
+    {
+        _threadId = Environment.CurrentManagedThreadId;
+        SetSynchronizationContext(this);
+    }
+
+    internal void Uninstall()
+    {
+        if (Current == this)
+        {
+            SetSynchronizationContext(null);
+        }
+
+        lock (_lock)
+        {
+            // Nothing pumps after this, threads blocked in Send must not wait for it
+            for (int i = 0; i < _count; i++)
+            {
+                _items[(_head + i) % _items.Length].Send?.Fail("The host thread stopped before the callback ran.");
+            }
+
+            Array.Clear(_items);
+            _head = 0;
+            _count = 0;
+            _threadId = -1;
+        }
+    }
+
+    // Continuations of plugins being unloaded would keep their load context alive
+    internal void RemoveOwnedBy(Assembly assembly)
+    {
+        lock (_lock)
+        {
+            int kept = 0;
+            for (int i = 0; i < _count; i++)
+            {
+                var item = _items[(_head + i) % _items.Length];
+                if (IsOwnedBy(item.Callback, assembly) || IsOwnedBy(item.State, assembly))
+                {
+                    item.Send?.Fail("The plugin was unloaded before the callback ran.");
+                    continue;
+                }
+
+                _items[(_head + kept) % _items.Length] = item;
+                kept++;
+            }
+
+            for (int i = kept; i < _count; i++)
+            {
+                _items[(_head + i) % _items.Length] = default;
+            }
+
+            _count = kept;
+        }
+    }
+
+    // Runs the continuations queued before the call, those they post wait for the next frame.
+    // At least one runs per call, the rest only while the budget (Stopwatch ticks, 0 for none) holds.
+    internal void Pump(long budget)
+    {
+        int pending;
+        lock (_lock)
+        {
+            pending = _count;
+        }
+
+        if (pending == 0)
+            return;
+
+        long start = Stopwatch.GetTimestamp();
+
+        for (int i = 0; i < pending; i++)
+        {
+            if (budget > 0 && i > 0 && Stopwatch.GetTimestamp() - start > budget)
+                break;
+
+            WorkItem item;
+            lock (_lock)
+            {
+                item = _items[_head];
+                _items[_head] = default;
+                _head = (_head + 1) % _items.Length;
+                _count--;
+            }
+
+            try
+            {
+                item.Callback(item.State);
+            }
+            catch (Exception e)
+            {
+                if (item.Send != null)
+                {
+                    item.Send.Error = ExceptionDispatchInfo.Capture(e);
+                }
+                else
+                {
+                    HandleException(e);
+                }
+            }
+            finally
+            {
+                item.Send?.Done.Set();
+            }
+        }
+    }
+
+    private void Enqueue(in WorkItem item)
+    {
+        if (_count == _items.Length)
+        {
+            Grow();
+        }
+
+        _items[(_head + _count) % _items.Length] = item;
+        _count++;
+    }
+
+    // Await continuations are posted as a runtime callback whose state is a delegate to a box around the
+    // plugin's state machine, so the owner can sit in the delegate, its target or a generic argument of that
+    private static bool IsOwnedBy(object? obj, Assembly assembly)
+    {
+        if (obj is Delegate d)
+            return d.Method.Module.Assembly == assembly || IsOwnedBy(d.Target, assembly);
+
+        if (obj == null)
+            return false;
+
+        var type = obj.GetType();
+        return type.Assembly == assembly || (type.IsGenericType && type.GetGenericArguments().Any(t => t.Assembly == assembly));
+    }
+
+    private void Grow()
+    {
+        var items = new WorkItem[_items.Length * 2];
+        for (int i = 0; i < _count; i++)
+        {
+            items[i] = _items[(_head + i) % _items.Length];
+        }
+
+        _items = items;
+        _head = 0;
+    }
+}
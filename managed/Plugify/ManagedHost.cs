@@ -18,17 +18,126 @@ internal static class ManagedHost
     private static unsafe delegate* unmanaged[Cdecl]<NativeString, void> ExceptionCallback;
     private static unsafe delegate* unmanaged[Cdecl]<NativeString, MessageLevel, void> MessageCallback;
 
+    // Must be bumped together with netlm::ManagedFunctionsVersion
+    private const int FunctionTableVersion = 8;
+
+    // Same order as the fields of netlm::ManagedFunctions (src/managed_functions.hpp). Taking the address
+    // of each entry point checks its name and signature when this assembly compiles.
+    private static unsafe nint[] CreateFunctionTable() =>
+    [
+        (nint)(delegate* unmanaged<delegate* unmanaged[Cdecl]<NativeString, MessageLevel, void>, delegate* unmanaged[Cdecl]<NativeString, void>, void>)&Initialize,
+        (nint)(delegate* unmanaged<void>)&Shutdown,
+        (nint)(delegate* unmanaged<Guid, Interop.InternalCall*, int, Bool32, void>)&Interop.InternalCallsManager.SetInternalCalls,
+        (nint)(delegate* unmanaged<NativeString, Bool32, Bool32, Guid>)&AssemblyLoader.LoadAssembly,
+        (nint)(delegate* unmanaged<Guid, Bool32>)&AssemblyLoader.UnloadAssembly,
+        (nint)(delegate* unmanaged<AssemblyLoadStatus>)&AssemblyLoader.GetLastLoadStatus,
+        (nint)(delegate* unmanaged<Guid, NativeString>)&AssemblyLoader.GetAssemblyName,
+        (nint)(delegate* unmanaged<Guid, NativeString*, nint*, ulong*, int, void>)&NativeExports.GetAssemblyExports,
+        (nint)(delegate* unmanaged<Guid, Guid*, void>)&NativeExports.GetAssemblyModuleVersionId,
+        (nint)(delegate* unmanaged<Guid, nint, int>)&NativeExports.GetTypeMetadataToken,
+        (nint)(delegate* unmanaged<Guid, nint, int>)&NativeExports.GetMethodInfoMetadataToken,
+        (nint)(delegate* unmanaged<Guid, int*, nint*, int, Bool32>)&NativeExports.ResolveMetadataTokens,
+        (nint)(delegate* unmanaged<int, GCCollectionMode, Bool32, Bool32, void>)&GarbageCollector.CollectGarbage,
+        (nint)(delegate* unmanaged<void>)&GarbageCollector.WaitForPendingFinalizers,
+        (nint)(delegate* unmanaged<nint, Bool32, nint, ManagedType*, int, nint>)&ManagedObject.CreateObject,
+        (nint)(delegate* unmanaged<nint, nint, nint, int, void>)&ManagedObject.InvokeMethod,
+        (nint)(delegate* unmanaged<nint, nint, nint, int, nint, void>)&ManagedObject.InvokeMethodRet,
+        (nint)(delegate* unmanaged<nint, nint, nint, int, void>)&ManagedObject.InvokeStaticMethod,
+        (nint)(delegate* unmanaged<nint, nint, nint, int, nint, void>)&ManagedObject.InvokeStaticMethodRet,
+        (nint)(delegate* unmanaged<nint, nint>)&ManagedObject.GetExportThunk,
+        (nint)(delegate* unmanaged<nint, nint*, uint*, int, int, nint, int, void>)&ManagedObject.InvokeExportBatch,
+        (nint)(delegate* unmanaged<nint, nint, int, void>)&ManagedObject.InvokeDelegate,
+        (nint)(delegate* unmanaged<nint, nint, int, nint, void>)&ManagedObject.InvokeDelegateRet,
+        (nint)(delegate* unmanaged<nint, NativeString, nint, void>)&ManagedObject.SetFieldValue,
+        (nint)(delegate* unmanaged<nint, NativeString, nint, void>)&ManagedObject.GetFieldValue,
+        (nint)(delegate* unmanaged<nint, NativeString, nint, void>)&ManagedObject.GetFieldPointer,
+        (nint)(delegate* unmanaged<nint, NativeString, nint, void>)&ManagedObject.SetPropertyValue,
+        (nint)(delegate* unmanaged<nint, NativeString, nint, void>)&ManagedObject.GetPropertyValue,
+        (nint)(delegate* unmanaged<nint, void>)&ManagedObject.DestroyObject,
+        (nint)(delegate* unmanaged<nint, nint, NativeString, Bool32>)&PluginUpdater.RegisterUpdate,
+        (nint)(delegate* unmanaged<nint, void>)&PluginUpdater.UnregisterUpdate,
+        (nint)(delegate* unmanaged<nint, Bool32, void>)&PluginUpdater.SetUpdateEnabled,
+        (nint)(delegate* unmanaged<float, void>)&PluginUpdater.UpdatePlugins,
+        (nint)(delegate* unmanaged<Guid, nint*, int*, void>)&TypeInterface.GetAssemblyTypes,
+        (nint)(delegate* unmanaged<Guid, nint*, NativeString*, NativeString*, int*, void>)&TypeInterface.GetAssemblyTypeNames,
+        (nint)(delegate* unmanaged<Guid, int*, byte*>)&TypeInterface.GetAssemblyMetadata,
+        (nint)(delegate* unmanaged<NativeString, nint*, void>)&TypeInterface.GetType,
+        (nint)(delegate* unmanaged<nint, NativeString>)&TypeInterface.GetFullTypeName,
+        (nint)(delegate* unmanaged<nint, NativeString>)&TypeInterface.GetAssemblyQualifiedName,
+        (nint)(delegate* unmanaged<nint, Guid>)&TypeInterface.GetTypeAssemblyId,
+        (nint)(delegate* unmanaged<nint, nint*, void>)&TypeInterface.GetBaseType,
+        (nint)(delegate* unmanaged<nint, int>)&TypeInterface.GetTypeSize,
+        (nint)(delegate* unmanaged<nint, nint, Bool32>)&TypeInterface.IsTypeSubclassOf,
+        (nint)(delegate* unmanaged<nint, nint, Bool32>)&TypeInterface.IsTypeAssignableTo,
+        (nint)(delegate* unmanaged<nint, nint, Bool32>)&TypeInterface.IsTypeAssignableFrom,
+        (nint)(delegate* unmanaged<nint, Bool32>)&TypeInterface.IsTypeSZArray,
+        (nint)(delegate* unmanaged<nint, Bool32>)&TypeInterface.IsTypeByRef,
+        (nint)(delegate* unmanaged<nint, nint*, void>)&TypeInterface.GetElementType,
+        (nint)(delegate* unmanaged<nint, nint*, int*, void>)&TypeInterface.GetTypeMethods,
+        (nint)(delegate* unmanaged<nint, nint*, int*, void>)&TypeInterface.GetTypeFields,
+        (nint)(delegate* unmanaged<nint, nint*, int*, void>)&TypeInterface.GetTypeProperties,
+        (nint)(delegate* unmanaged<nint, NativeString, nint*, void>)&TypeInterface.GetTypeMethod,
+        (nint)(delegate* unmanaged<nint, NativeString, nint*, void>)&TypeInterface.GetTypeField,
+        (nint)(delegate* unmanaged<nint, NativeString, nint*, void>)&TypeInterface.GetTypeProperty,
+        (nint)(delegate* unmanaged<nint, nint, Bool32>)&TypeInterface.HasTypeAttribute,
+        (nint)(delegate* unmanaged<nint, nint*, int*, void>)&TypeInterface.GetTypeAttributes,
+        (nint)(delegate* unmanaged<nint, ManagedType>)&TypeInterface.GetTypeManagedType,
+        (nint)(delegate* unmanaged<nint, NativeString>)&TypeInterface.GetMethodInfoName,
+        (nint)(delegate* unmanaged<nint, nint>)&TypeInterface.GetMethodInfoFunctionAddress,
+        (nint)(delegate* unmanaged<nint, nint*, void>)&TypeInterface.GetMethodInfoReturnType,
+        (nint)(delegate* unmanaged<nint, nint*, int*, void>)&TypeInterface.GetMethodInfoParameterTypes,
+        (nint)(delegate* unmanaged<nint, TypeInterface.TypeAccessibility>)&TypeInterface.GetMethodInfoAccessibility,
+        (nint)(delegate* unmanaged<nint, nint*, int*, void>)&TypeInterface.GetMethodInfoAttributes,
+        (nint)(delegate* unmanaged<nint, int, nint*, int*, void>)&TypeInterface.GetMethodInfoParameterAttributes,
+        (nint)(delegate* unmanaged<nint, nint*, int*, void>)&TypeInterface.GetMethodInfoReturnAttributes,
+        (nint)(delegate* unmanaged<nint, NativeString>)&TypeInterface.GetFieldInfoName,
+        (nint)(delegate* unmanaged<nint, nint*, void>)&TypeInterface.GetFieldInfoType,
+        (nint)(delegate* unmanaged<nint, TypeInterface.TypeAccessibility>)&TypeInterface.GetFieldInfoAccessibility,
+        (nint)(delegate* unmanaged<nint, nint*, int*, void>)&TypeInterface.GetFieldInfoAttributes,
+        (nint)(delegate* unmanaged<nint, NativeString>)&TypeInterface.GetPropertyInfoName,
+        (nint)(delegate* unmanaged<nint, nint*, void>)&TypeInterface.GetPropertyInfoType,
+        (nint)(delegate* unmanaged<nint, nint*, int*, void>)&TypeInterface.GetPropertyInfoAttributes,
+        (nint)(delegate* unmanaged<nint, NativeString, nint, void>)&TypeInterface.GetAttributeFieldValue,
+        (nint)(delegate* unmanaged<nint, nint*, void>)&TypeInterface.GetAttributeType,
+        (nint)(delegate* unmanaged<nint, Bool32>)&TypeInterface.IsClass,
+        (nint)(delegate* unmanaged<nint, Bool32>)&TypeInterface.IsEnum,
+        (nint)(delegate* unmanaged<nint, Bool32>)&TypeInterface.IsValueType,
+        (nint)(delegate* unmanaged<nint, NativeString*, int*, void>)&TypeInterface.GetEnumNames,
+        (nint)(delegate* unmanaged<nint, long*, int*, void>)&TypeInterface.GetEnumValues,
+    ];
+
     [UnmanagedCallersOnly]
-    private static unsafe void Initialize(delegate* unmanaged[Cdecl]<NativeString, MessageLevel, void> messageCallback, delegate* unmanaged[Cdecl]<NativeString, void> exceptionCallback)
+    private static unsafe Bool32 Bootstrap(nint* functions, int count, int version)
+    {
+        nint[] table = CreateFunctionTable();
+
+        // Nothing can be logged yet, the native side reports the failure
+        if (version != FunctionTableVersion || count != table.Length)
+        {
+            return false;
+        }
+
+        table.CopyTo(new Span<nint>(functions, count));
+        return true;
+    }
+
+    [UnmanagedCallersOnly]
+    internal static unsafe void Initialize(delegate* unmanaged[Cdecl]<NativeString, MessageLevel, void> messageCallback, delegate* unmanaged[Cdecl]<NativeString, void> exceptionCallback)
     {
         MessageCallback = messageCallback;
         ExceptionCallback = exceptionCallback;
+
+        MainThreadSynchronizationContext.Instance.Install();
     }
 
     [UnmanagedCallersOnly]
-    private static void Shutdown()
+    internal static void Shutdown()
     {
         //ManagedObject.CachedMethods.Clear();
+        ManagedObject.CachedThunks.Clear();
+        PluginUpdater.Clear();
+        Timers.Clear();
+        MainThreadSynchronizationContext.Instance.Uninstall();
 
         TypeInterface.CachedTypes.Clear();
         TypeInterface.CachedMethods.Clear();
@@ -38,6 +147,7 @@ internal static class ManagedHost
         
         Marshalling.CachedDelegates.Clear();
         Marshalling.CachedFunctions.Clear();
+        Marshalling.CachedCompletions.Clear();
         Marshalling.CachedMethods.Clear();
         
         Marshalling.CachedGetters.Clear();
@@ -62,9 +62,82 @@ internal static class ManagedObject
     {
         return CachedInvokers.GetOrAdd(methodInfo, DelegateHelpers.CreateInvokeDelegate);
     }
+
+    internal static readonly ConcurrentDictionary<MethodInfo, ExportThunk?> CachedThunks = new();
+
+    internal static void RemoveCachedThunks(Assembly assembly)
+    {
+        foreach (var methodInfo in CachedThunks.Keys)
+        {
+            if (methodInfo.DeclaringType?.Assembly == assembly)
+            {
+                CachedThunks.TryRemove(methodInfo, out _);
+            }
+        }
+    }
+
+    [UnmanagedCallersOnly]
+    internal static nint GetExportThunk(nint methodHandle)
+    {
+        try
+        {
+            if (!TypeInterface.CachedMethods.TryGetValue(methodHandle, out var methodInfo))
+            {
+                LogMessage($"Cannot find method {methodHandle}.", MessageLevel.Error);
+                return nint.Zero;
+            }
+
+            var thunk = CachedThunks.GetOrAdd(methodInfo, DelegateHelpers.CreateExportThunk);
+            return thunk != null ? Marshal.GetFunctionPointerForDelegate(thunk) : nint.Zero;
+        }
+        catch (Exception e)
+        {
+            HandleException(e);
+            return nint.Zero;
+        }
+    }
     
+    // One transition for the whole batch: row r of parameter i lives at columns[i] + r * strides[i],
+    // its result at results + r * resultStride, and every row goes straight through the export thunk
+    [UnmanagedCallersOnly]
+    internal static unsafe void InvokeExportBatch(nint methodHandle, nint* columns, uint* strides, int parameterCount, int count, nint results, int resultStride)
+    {
+        try
+        {
+            if (!TypeInterface.CachedMethods.TryGetValue(methodHandle, out var methodInfo))
+            {
+                LogMessage($"Cannot find method {methodHandle}.", MessageLevel.Error);
+                return;
+            }
+
+            var thunk = CachedThunks.GetOrAdd(methodInfo, DelegateHelpers.CreateExportThunk);
+            if (thunk == null)
+            {
+                LogMessage($"Method {methodInfo.Name} cannot be invoked in batches.", MessageLevel.Error);
+                return;
+            }
+
+            nint* arguments = stackalloc nint[Math.Max(parameterCount, 1)];
+
+            for (int row = 0; row < count; row++)
+            {
+                for (int i = 0; i < parameterCount; i++)
+                {
+                    arguments[i] = columns[i] + (nint)row * (nint)strides[i];
+                }
+
+                // The thunk reports an exception itself, so a throwing row doesn't cancel the rows after it
+                thunk((nint)arguments, results != nint.Zero ? results + (nint)row * resultStride : nint.Zero);
+            }
+        }
+        catch (Exception e)
+        {
+            HandleException(e);
+        }
+    }
+
     [UnmanagedCallersOnly]
-    private static unsafe nint CreateObject(nint typeHandle, Bool32 weakRef, nint parameterPtr, ManagedType* parameterTypes, int parameterCount)
+    internal static unsafe nint CreateObject(nint typeHandle, Bool32 weakRef, nint parameterPtr, ManagedType* parameterTypes, int parameterCount)
     {
         try
         {
@@ -132,7 +205,7 @@ internal static class ManagedObject
     }
 
     [UnmanagedCallersOnly]
-    private static void DestroyObject(nint objectHandle)
+    internal static void DestroyObject(nint objectHandle)
     {
         try
         {
@@ -187,7 +260,7 @@ internal static class ManagedObject
     }*/
 
     [UnmanagedCallersOnly]
-    private static void InvokeStaticMethod(nint typeHandle, nint methodHandle, nint parameterPtr, int parameterCount)
+    internal static void InvokeStaticMethod(nint typeHandle, nint methodHandle, nint parameterPtr, int parameterCount)
     {
         try
         {
@@ -218,7 +291,7 @@ internal static class ManagedObject
     }
 
     [UnmanagedCallersOnly]
-    private static void InvokeStaticMethodRet(nint typeHandle, nint methodHandle, nint parameterPtr, int parameterCount, nint resultStorage)
+    internal static void InvokeStaticMethodRet(nint typeHandle, nint methodHandle, nint parameterPtr, int parameterCount, nint resultStorage)
     {
         try
         {
@@ -253,7 +326,7 @@ internal static class ManagedObject
     }
 
     [UnmanagedCallersOnly]
-    private static void InvokeMethod(nint objectHandle, nint methodHandle, nint parameterPtr, int parameterCount)
+    internal static void InvokeMethod(nint objectHandle, nint methodHandle, nint parameterPtr, int parameterCount)
     {
         try
         {
@@ -286,7 +359,7 @@ internal static class ManagedObject
     }
 
     [UnmanagedCallersOnly]
-    private static void InvokeMethodRet(nint objectHandle, nint methodHandle, nint parameterPtr, int parameterCount, nint resultStorage)
+    internal static void InvokeMethodRet(nint objectHandle, nint methodHandle, nint parameterPtr, int parameterCount, nint resultStorage)
     {
         try
         {
@@ -323,7 +396,7 @@ internal static class ManagedObject
     }
 
     [UnmanagedCallersOnly]
-    private static void InvokeDelegate(nint delegateHandle, nint parameterPtr, int parameterCount)
+    internal static void InvokeDelegate(nint delegateHandle, nint parameterPtr, int parameterCount)
     {
         try
         {
@@ -348,7 +421,7 @@ internal static class ManagedObject
     }
 
     [UnmanagedCallersOnly]
-    private static void InvokeDelegateRet(nint delegateHandle, nint parameterPtr, int parameterCount, nint resultStorage)
+    internal static void InvokeDelegateRet(nint delegateHandle, nint parameterPtr, int parameterCount, nint resultStorage)
     {
         try
         {
@@ -377,7 +450,7 @@ internal static class ManagedObject
     }
     
     [UnmanagedCallersOnly]
-    private static void SetFieldValue(nint targetPtr, NativeString fieldName, nint inValue)
+    internal static void SetFieldValue(nint targetPtr, NativeString fieldName, nint inValue)
     {
         try
         {
@@ -408,7 +481,7 @@ internal static class ManagedObject
     }
 
     [UnmanagedCallersOnly]
-    private static void GetFieldValue(nint targetPtr, NativeString fieldName, nint outValue)
+    internal static void GetFieldValue(nint targetPtr, NativeString fieldName, nint outValue)
     {
         try
         {
@@ -438,7 +511,7 @@ internal static class ManagedObject
     }
 
     [UnmanagedCallersOnly]
-    private static void GetFieldPointer(nint targetPtr, NativeString fieldName, nint outValue)
+    internal static void GetFieldPointer(nint targetPtr, NativeString fieldName, nint outValue)
     {
         try
         {
@@ -479,7 +552,7 @@ internal static class ManagedObject
     }
     
     [UnmanagedCallersOnly]
-    private static void SetPropertyValue(nint targetPtr, NativeString propertyName, nint inValue)
+    internal static void SetPropertyValue(nint targetPtr, NativeString propertyName, nint inValue)
     {
         try
         {
@@ -516,7 +589,7 @@ internal static class ManagedObject
     }
 
     [UnmanagedCallersOnly]
-    private static void GetPropertyValue(nint targetPtr, NativeString propertyName, nint outValue)
+    internal static void GetPropertyValue(nint targetPtr, NativeString propertyName, nint outValue)
     {
         try
         {
@@ -6,7 +6,8 @@ namespace Plugify;
 internal struct ManagedType(Type type)
 {
     private byte valueType = (byte)(type.ToValueType());
-    private byte reference = (byte)(type.IsByRef ? 1 : 0);
+    // A NativeVector stands for a by-ref array, so the native side has to pass it by reference too
+    private byte reference = (byte)(type.IsByRef || type.GetNativeVectorElementType() != null ? 1 : 0);
 
     public ValueType ValueType => (ValueType) valueType;
     public bool IsByRef => reference == 1;
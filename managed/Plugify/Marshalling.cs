@@ -17,6 +17,7 @@ public static class Marshalling
     
     internal static readonly ConcurrentDictionary<Delegate, Callback> CachedDelegates = new();
     internal static readonly ConcurrentDictionary<nint, Delegate> CachedFunctions = new();
+    internal static readonly ConcurrentDictionary<(nint, Type), Delegate> CachedCompletions = new();
     internal static readonly ConcurrentDictionary<MethodInfo, bool> CachedMethods = new();
     
     internal static readonly ConcurrentDictionary<Type, Func<nint, Array>> CachedGetters = new();
@@ -45,6 +46,12 @@ public static class Marshalling
             ParameterInfo parameterInfo = parameterInfos[i];
             Type paramType = parameterInfo.ParameterType;
 
+            // A view can't be boxed, only the export thunk can pass one
+            if (paramType.IsViewType())
+            {
+                throw new NotSupportedException($"Method {methodInfo.Name} cannot be invoked by reflection, parameter {parameterInfo.Name} is a {paramType.Name} view.");
+            }
+
             parameters[i] = MarshalPointer(paramPtr, paramType);
         }
 
@@ -466,7 +473,7 @@ public static class Marshalling
 			MethodInfo methodInfo = delegateType.GetInvokeMethod();
 			if (CachedMethods.GetOrAdd(methodInfo, CheckIfNeedsMarshal))
 			{
-				return DelegateHelpers.CreateObjectArrayDelegate(delegateType, ExternalInvoke(address, methodInfo), $"0x{address:X}");
+				return ExternalInvoke(address, delegateType, methodInfo);
 			}
 			else
 			{
@@ -475,32 +482,29 @@ public static class Marshalling
 		});
 	}
 
+	// Generic delegate types (Action<T>) can't go through Marshal.GetDelegateForFunctionPointer, they always take the JIT path
+	internal static Delegate GetCompletionDelegate(nint funcAddress, Type delegateType)
+	{
+		// Keyed by type too, the same callback may be awaited with different result types
+		return CachedCompletions.GetOrAdd((funcAddress, delegateType), static key => ExternalInvoke(key.Item1, key.Item2, key.Item2.GetInvokeMethod()));
+	}
+
 	private static readonly bool IsArm = RuntimeInformation.ProcessArchitecture == Architecture.Arm64 || RuntimeInformation.ProcessArchitecture == Architecture.Arm;
 	private static readonly bool Is32Bit = IntPtr.Size == 4;
 	private static readonly bool IsWindows = RuntimeInformation.IsOSPlatform(OSPlatform.Windows);
 	
-	private static unsafe Func<object?[], object?> ExternalInvoke(nint funcAddress, MethodInfo methodInfo)
+	private static unsafe Delegate ExternalInvoke(nint funcAddress, Type delegateType, MethodInfo methodInfo)
 	{
 		ManagedType returnType =  new ManagedType(methodInfo.ReturnParameter.ParameterType);
 		ManagedType[] parameterTypes = methodInfo.GetParameters().Select(p => new ManagedType(p.ParameterType)).ToArray();
 		
 		bool hasRet = returnType.ValueType is >= ValueType._ObjectStart and <= ValueType._ObjectEnd;
-		//bool hasRefs = parameterTypes.Any(t => t.IsByRef);
 		
 		if (!hasRet)
 		{
 			ValueType firstHidden = (IsWindows && !IsArm) || Is32Bit ? ValueType.Vector3 : ValueType.Matrix4x4;
 			hasRet = returnType.ValueType >= firstHidden && returnType.ValueType <= ValueType.Matrix4x4;
 		}
-		
-		int paramCount = parameterTypes.Length;
-		//int objectCount = parameterTypes.Select(t => t.ValueType is >= ValueType._ObjectStart and <= ValueType._ObjectEnd).Count();
-		
-		if (hasRet)
-		{
-			//++objectCount;
-			++paramCount;
-		}
 
 		JitCall jit = new JitCall(funcAddress, parameterTypes, returnType);
 		if (jit.Function == null)
@@ -508,1645 +512,7 @@ public static class Marshalling
 			throw new InvalidOperationException($"{methodInfo.Name} (jit error: {jit.Error})");
 		}
 
-		return parameters =>
-		{
-			Arena arena = new Arena(stackalloc byte[4096]);
-			Defer defer = new Defer(paramCount);
-			ulong* @params = stackalloc ulong[paramCount];
-			ulong* @return = stackalloc ulong[2]{ 0, 0 }; // 128bits to fit Vector4
-					
-			object? ret = null;
-			
-			nint Pin<T>(T val, ref Arena arena, int size) where T : unmanaged
-			{
-				var tmp = (T*)arena.Alloc(size);
-				*tmp = val;
-				return (nint)tmp;
-			}
-
-			nint Raw<T>(T val) where T : unmanaged
-			{
-				return *(nint*)&val;
-			}
-
-			int index = 0;
-
-			try
-			{
-				var retType = returnType.ValueType;
-				if (hasRet)
-				{
-					var size = TypeUtils.SizeOf(retType);
-					var ptr = arena.Alloc(size);
-					switch (retType)
-					{
-						case ValueType.Vector2:
-						case ValueType.Vector3:
-						case ValueType.Vector4:
-						case ValueType.Matrix4x4:
-							break;
-						case ValueType.String:
-							defer.Add(() => NativeMethods.DestroyString((String192*)ptr));
-							break;
-						case ValueType.Any:
-							defer.Add(() => NativeMethods.DestroyVariant((Variant256*)ptr));
-							break;
-						case ValueType.ArrayBool:
-							defer.Add(() => NativeMethods.DestroyVectorBool((Vector192*)ptr));
-							break;
-						case ValueType.ArrayChar8:
-							defer.Add(() => NativeMethods.DestroyVectorChar8((Vector192*)ptr));
-							break;
-						case ValueType.ArrayChar16:
-							defer.Add(() => NativeMethods.DestroyVectorChar16((Vector192*)ptr));
-							break;
-						case ValueType.ArrayInt8:
-							defer.Add(() => NativeMethods.DestroyVectorInt8((Vector192*)ptr));
-							break;
-						case ValueType.ArrayInt16:
-							defer.Add(() => NativeMethods.DestroyVectorInt16((Vector192*)ptr));
-							break;
-						case ValueType.ArrayInt32:
-							defer.Add(() => NativeMethods.DestroyVectorInt32((Vector192*)ptr));
-							break;
-						case ValueType.ArrayInt64:
-							defer.Add(() => NativeMethods.DestroyVectorInt64((Vector192*)ptr));
-							break;
-						case ValueType.ArrayUInt8:
-							defer.Add(() => NativeMethods.DestroyVectorUInt8((Vector192*)ptr));
-							break;
-						case ValueType.ArrayUInt16:
-							defer.Add(() => NativeMethods.DestroyVectorUInt16((Vector192*)ptr));
-							break;
-						case ValueType.ArrayUInt32:
-							defer.Add(() => NativeMethods.DestroyVectorUInt32((Vector192*)ptr));
-							break;
-						case ValueType.ArrayUInt64:
-							defer.Add(() => NativeMethods.DestroyVectorUInt64((Vector192*)ptr));
-							break;
-						case ValueType.ArrayPointer:
-							defer.Add(() => NativeMethods.DestroyVectorIntPtr((Vector192*)ptr));
-							break;
-						case ValueType.ArrayFloat:
-							defer.Add(() => NativeMethods.DestroyVectorFloat((Vector192*)ptr));
-							break;
-						case ValueType.ArrayDouble:
-							defer.Add(() => NativeMethods.DestroyVectorDouble((Vector192*)ptr));
-							break;
-						case ValueType.ArrayString:
-							defer.Add(() => NativeMethods.DestroyVectorString((Vector192*)ptr));
-							break;
-						case ValueType.ArrayAny:
-							defer.Add(() => NativeMethods.DestroyVectorVariant((Vector192*)ptr));
-							break;
-						case ValueType.ArrayVector2:
-							defer.Add(() => NativeMethods.DestroyVectorVector2((Vector192*)ptr));
-							break;
-						case ValueType.ArrayVector3:
-							defer.Add(() => NativeMethods.DestroyVectorVector3((Vector192*)ptr));
-							break;
-						case ValueType.ArrayVector4:
-							defer.Add(() => NativeMethods.DestroyVectorVector4((Vector192*)ptr));
-							break;
-						case ValueType.ArrayMatrix4x4:
-							defer.Add(() => NativeMethods.DestroyVectorMatrix4x4((Vector192*)ptr));
-							break;
-						default:
-							throw new TypeNotFoundException();
-					}
-
-					@params[index++] = (ulong)ptr;
-				}
-
-				for (int i = 0; i < parameters.Length; i++)
-				{
-					object paramValue = parameters[i]!;
-					ManagedType paramType = parameterTypes[i];
-					ValueType valueType = paramType.ValueType;
-					var size = TypeUtils.SizeOf(valueType);
-					nint ptr;
-
-					if (paramType.IsByRef)
-					{
-						int at = i;
-						switch (valueType)
-						{
-							case ValueType.Bool:
-								ptr = Pin((Bool8)paramValue, ref arena, size);
-								defer.Add(() => { parameters[at] = *(Bool8*)ptr; });
-								break;
-							case ValueType.Char8:
-								ptr = Pin((Char8)paramValue, ref arena, size);
-								defer.Add(() => { parameters[at] = *(Char8*)ptr; });
-								break;
-							case ValueType.Char16:
-								ptr = Pin((Char16)paramValue, ref arena, size);
-								defer.Add(() => { parameters[at] = *(Char16*)ptr; });
-								break;
-							case ValueType.Int8:
-								ptr = Pin((sbyte)paramValue, ref arena, size);
-								defer.Add(() => { parameters[at] = *(sbyte*)ptr; });
-								break;
-							case ValueType.Int16:
-								ptr = Pin((short)paramValue, ref arena, size);
-								defer.Add(() => { parameters[at] = *(short*)ptr; });
-								break;
-							case ValueType.Int32:
-								ptr = Pin((int)paramValue, ref arena, size);
-								defer.Add(() => { parameters[at] = *(int*)ptr; });
-								break;
-							case ValueType.Int64:
-								ptr = Pin((long)paramValue, ref arena, size);
-								defer.Add(() => { parameters[at] = *(long*)ptr; });
-								break;
-							case ValueType.UInt8:
-								ptr = Pin((byte)paramValue, ref arena, size);
-								defer.Add(() => { parameters[at] = *(byte*)ptr; });
-								break;
-							case ValueType.UInt16:
-								ptr = Pin((ushort)paramValue, ref arena, size);
-								defer.Add(() => { parameters[at] = *(ushort*)ptr; });
-								break;
-							case ValueType.UInt32:
-								ptr = Pin((uint)paramValue, ref arena, size);
-								defer.Add(() => { parameters[at] = *(uint*)ptr; });
-								break;
-							case ValueType.UInt64:
-								ptr = Pin((ulong)paramValue, ref arena, size);
-								defer.Add(() => { parameters[at] = *(ulong*)ptr; });
-								break;
-							case ValueType.Pointer:
-								ptr = Pin((nint)paramValue, ref arena, size);
-								defer.Add(() => { parameters[at] = *(nint*)ptr; });
-								break;
-							case ValueType.Float:
-								ptr = Pin((float)paramValue, ref arena, size);
-								defer.Add(() => { parameters[at] = *(float*)ptr; });
-								break;
-							case ValueType.Double:
-								ptr = Pin((double)paramValue, ref arena, size);
-								defer.Add(() => { parameters[at] = *(double*)ptr; });
-								break;
-							case ValueType.Vector2:
-								ptr = Pin((Vector2)paramValue, ref arena, size);
-								defer.Add(() => { parameters[at] = *(Vector2*)ptr; });
-								break;
-							case ValueType.Vector3:
-								ptr = Pin((Vector3)paramValue, ref arena, size);
-								defer.Add(() => { parameters[at] = *(Vector3*)ptr; });
-								break;
-							case ValueType.Vector4:
-								ptr = Pin((Vector4)paramValue, ref arena, size);
-								defer.Add(() => { parameters[at] = *(Vector4*)ptr; });
-								break;
-							case ValueType.Matrix4x4:
-								ptr = Pin((Matrix4x4)paramValue, ref arena, size);
-								defer.Add(() => { parameters[at] = *(Matrix4x4*)ptr; });
-								break;
-							case ValueType.Function:
-								ptr = GetFunctionPointerForDelegate((Delegate)paramValue);
-								break;
-							case ValueType.String:
-								ptr = Pin(NativeMethods.ConstructString((string)paramValue), ref arena, size);
-								defer.Add(() =>
-								{
-									parameters[at] = NativeMethods.GetStringData((String192*)ptr);
-									NativeMethods.DestroyString((String192*)ptr);
-								});
-								break;
-							case ValueType.Any:
-								ptr = Pin(NativeMethods.ConstructVariant((object)paramValue), ref arena, size);
-								defer.Add(() =>
-								{
-									parameters[at] = NativeMethods.GetVariantData((Variant256*)ptr)!;
-									NativeMethods.DestroyVariant((Variant256*)ptr);
-								});
-								break;
-							case ValueType.ArrayBool:
-								ptr = Pin(NativeMethods.ConstructVectorBool((Bool8[])paramValue), ref arena, size);
-								defer.Add(() =>
-								{
-									parameters[at] = NativeMethods.GetVectorDataBool((Vector192*)ptr);
-									NativeMethods.DestroyVectorBool((Vector192*)ptr);
-								});
-								break;
-							case ValueType.ArrayChar8:
-								ptr = Pin(NativeMethods.ConstructVectorChar8((Char8[])paramValue), ref arena, size);
-								defer.Add(() =>
-								{
-									parameters[at] = NativeMethods.GetVectorDataChar8((Vector192*)ptr);
-									NativeMethods.DestroyVectorChar8((Vector192*)ptr);
-								});
-								break;
-							case ValueType.ArrayChar16:
-								ptr = Pin(NativeMethods.ConstructVectorChar16((Char16[])paramValue), ref arena, size);
-								defer.Add(() =>
-								{
-									parameters[at] = NativeMethods.GetVectorDataChar16((Vector192*)ptr);
-									NativeMethods.DestroyVectorChar16((Vector192*)ptr);
-								});
-								break;
-							case ValueType.ArrayInt8:
-								ptr = Pin(NativeMethods.ConstructVectorInt8((sbyte[])paramValue), ref arena, size);
-								defer.Add(() =>
-								{
-									parameters[at] = NativeMethods.GetVectorDataInt8((Vector192*)ptr);
-									NativeMethods.DestroyVectorInt8((Vector192*)ptr);
-								});
-								break;
-							case ValueType.ArrayInt16:
-								ptr = Pin(NativeMethods.ConstructVectorInt16((short[])paramValue), ref arena, size);
-								defer.Add(() =>
-								{
-									parameters[at] = NativeMethods.GetVectorDataInt16((Vector192*)ptr);
-									NativeMethods.DestroyVectorInt16((Vector192*)ptr);
-								});
-								break;
-							case ValueType.ArrayInt32:
-								ptr = Pin(NativeMethods.ConstructVectorInt32((int[])paramValue), ref arena, size);
-								defer.Add(() =>
-								{
-									parameters[at] = NativeMethods.GetVectorDataInt32((Vector192*)ptr);
-									NativeMethods.DestroyVectorInt32((Vector192*)ptr);
-								});
-								break;
-							case ValueType.ArrayInt64:
-								ptr = Pin(NativeMethods.ConstructVectorInt64((long[])paramValue), ref arena, size);
-								defer.Add(() =>
-								{
-									parameters[at] = NativeMethods.GetVectorDataInt64((Vector192*)ptr);
-									NativeMethods.DestroyVectorInt64((Vector192*)ptr);
-								});
-								break;
-							case ValueType.ArrayUInt8:
-								ptr = Pin(NativeMethods.ConstructVectorUInt8((byte[])paramValue), ref arena, size);
-								defer.Add(() =>
-								{
-									parameters[at] = NativeMethods.GetVectorDataUInt8((Vector192*)ptr);
-									NativeMethods.DestroyVectorUInt8((Vector192*)ptr);
-								});
-								break;
-							case ValueType.ArrayUInt16:
-								ptr = Pin(NativeMethods.ConstructVectorUInt16((ushort[])paramValue), ref arena, size);
-								defer.Add(() =>
-								{
-									parameters[at] = NativeMethods.GetVectorDataUInt16((Vector192*)ptr);
-									NativeMethods.DestroyVectorUInt16((Vector192*)ptr);
-								});
-								break;
-							case ValueType.ArrayUInt32:
-								ptr = Pin(NativeMethods.ConstructVectorUInt32((uint[])paramValue), ref arena, size);
-								defer.Add(() =>
-								{
-									parameters[at] = NativeMethods.GetVectorDataUInt32((Vector192*)ptr);
-									NativeMethods.DestroyVectorUInt32((Vector192*)ptr);
-								});
-								break;
-							case ValueType.ArrayUInt64:
-								ptr = Pin(NativeMethods.ConstructVectorUInt64((ulong[])paramValue), ref arena, size);
-								defer.Add(() =>
-								{
-									parameters[at] = NativeMethods.GetVectorDataUInt64((Vector192*)ptr);
-									NativeMethods.DestroyVectorUInt64((Vector192*)ptr);
-								});
-								break;
-							case ValueType.ArrayPointer:
-								ptr = Pin(NativeMethods.ConstructVectorIntPtr((nint[])paramValue), ref arena, size);
-								defer.Add(() =>
-								{
-									parameters[at] = NativeMethods.GetVectorDataIntPtr((Vector192*)ptr);
-									NativeMethods.DestroyVectorIntPtr((Vector192*)ptr);
-								});
-								break;
-							case ValueType.ArrayFloat:
-								ptr = Pin(NativeMethods.ConstructVectorFloat((float[])paramValue), ref arena, size);
-								defer.Add(() =>
-								{
-									parameters[at] = NativeMethods.GetVectorDataFloat((Vector192*)ptr);
-									NativeMethods.DestroyVectorFloat((Vector192*)ptr);
-								});
-								break;
-							case ValueType.ArrayDouble:
-								ptr = Pin(NativeMethods.ConstructVectorDouble((double[])paramValue), ref arena, size);
-								defer.Add(() =>
-								{
-									parameters[at] = NativeMethods.GetVectorDataDouble((Vector192*)ptr);
-									NativeMethods.DestroyVectorDouble((Vector192*)ptr);
-								});
-								break;
-							case ValueType.ArrayString:
-								ptr = Pin(NativeMethods.ConstructVectorString((string[])paramValue), ref arena, size);
-								defer.Add(() =>
-								{
-									parameters[at] = NativeMethods.GetVectorDataString((Vector192*)ptr);
-									NativeMethods.DestroyVectorString((Vector192*)ptr);
-								});
-								break;
-							case ValueType.ArrayAny:
-								ptr = Pin(NativeMethods.ConstructVectorVariant((object[])paramValue), ref arena, size);
-								defer.Add(() =>
-								{
-									parameters[at] = NativeMethods.GetVectorDataVariant((Vector192*)ptr);
-									NativeMethods.DestroyVectorVariant((Vector192*)ptr);
-								});
-								break;
-							case ValueType.ArrayVector2:
-								ptr = Pin(NativeMethods.ConstructVectorVector2((Vector2[])paramValue), ref arena, size);
-								defer.Add(() =>
-								{
-									parameters[at] = NativeMethods.GetVectorDataVector2((Vector192*)ptr);
-									NativeMethods.DestroyVectorVector2((Vector192*)ptr);
-								});
-								break;
-							case ValueType.ArrayVector3:
-								ptr = Pin(NativeMethods.ConstructVectorVector3((Vector3[])paramValue), ref arena, size);
-								defer.Add(() =>
-								{
-									parameters[at] = NativeMethods.GetVectorDataVector3((Vector192*)ptr);
-									NativeMethods.DestroyVectorVector3((Vector192*)ptr);
-								});
-								break;
-							case ValueType.ArrayVector4:
-								ptr = Pin(NativeMethods.ConstructVectorVector4((Vector4[])paramValue), ref arena, size);
-								defer.Add(() =>
-								{
-									parameters[at] = NativeMethods.GetVectorDataVector4((Vector192*)ptr);
-									NativeMethods.DestroyVectorVector4((Vector192*)ptr);
-								});
-								break;
-							case ValueType.ArrayMatrix4x4:
-								ptr = Pin(NativeMethods.ConstructVectorMatrix4x4((Matrix4x4[])paramValue), ref arena, size);
-								defer.Add(() =>
-								{
-									parameters[at] = NativeMethods.GetVectorDataMatrix4x4((Vector192*)ptr);
-									NativeMethods.DestroyVectorMatrix4x4((Vector192*)ptr);
-								});
-								break;
-							default:
-								throw new TypeNotFoundException($"Parameter '{parameterTypes[i].ValueType}' uses not supported type for marshalling!");
-						}
-					}
-					else
-					{
-						switch (valueType)
-						{
-							case ValueType.Bool:
-								ptr = Raw((Bool8)paramValue);
-								break;
-							case ValueType.Char8:
-								ptr = Raw((Char8)paramValue);
-								break;
-							case ValueType.Char16:
-								ptr = Raw((Char16)paramValue);
-								break;
-							case ValueType.Int8:
-								ptr = Raw((sbyte)paramValue);
-								break;
-							case ValueType.Int16:
-								ptr = Raw((short)paramValue);
-								break;
-							case ValueType.Int32:
-								ptr = Raw((int)paramValue);
-								break;
-							case ValueType.Int64:
-								ptr = Raw((long)paramValue);
-								break;
-							case ValueType.UInt8:
-								ptr = Raw((byte)paramValue);
-								break;
-							case ValueType.UInt16:
-								ptr = Raw((ushort)paramValue);
-								break;
-							case ValueType.UInt32:
-								ptr = Raw((uint)paramValue);
-								break;
-							case ValueType.UInt64:
-								ptr = Raw((ulong)paramValue);
-								break;
-							case ValueType.Pointer:
-								ptr = Raw((nint)paramValue);
-								break;
-							case ValueType.Float:
-								ptr = Raw((float)paramValue);
-								break;
-							case ValueType.Double:
-								ptr = Raw((double)paramValue);
-								break;
-							case ValueType.Vector2:
-								ptr = Pin((Vector2)paramValue, ref arena, size);
-								break;
-							case ValueType.Vector3:
-								ptr = Pin((Vector3)paramValue, ref arena, size);
-								break;
-							case ValueType.Vector4:
-								ptr = Pin((Vector4)paramValue, ref arena, size);
-								break;
-							case ValueType.Matrix4x4:
-								ptr = Pin((Matrix4x4)paramValue, ref arena, size);
-								break;
-							case ValueType.Function:
-								ptr = GetFunctionPointerForDelegate((Delegate)paramValue);
-								break;
-							case ValueType.String:
-								ptr = Pin(NativeMethods.ConstructString((string)paramValue), ref arena, size);
-								defer.Add(() => NativeMethods.DestroyString((String192*)ptr));
-								break;
-							case ValueType.Any:
-								ptr = Pin(NativeMethods.ConstructVariant((object)paramValue), ref arena, size);
-								defer.Add(() => NativeMethods.DestroyVariant((Variant256*)ptr));
-								break;
-							case ValueType.ArrayBool:
-								ptr = Pin(NativeMethods.ConstructVectorBool((Bool8[])paramValue), ref arena, size);
-								defer.Add(() => NativeMethods.DestroyVectorBool((Vector192*)ptr));
-								break;
-							case ValueType.ArrayChar8:
-								ptr = Pin(NativeMethods.ConstructVectorChar8((Char8[])paramValue), ref arena, size);
-								defer.Add(() => NativeMethods.DestroyVectorChar8((Vector192*)ptr));
-								break;
-							case ValueType.ArrayChar16:
-								ptr = Pin(NativeMethods.ConstructVectorChar16((Char16[])paramValue), ref arena, size);
-								defer.Add(() => NativeMethods.DestroyVectorChar16((Vector192*)ptr));
-								break;
-							case ValueType.ArrayInt8:
-								ptr = Pin(NativeMethods.ConstructVectorInt8((sbyte[])paramValue), ref arena, size);
-								defer.Add(() => NativeMethods.DestroyVectorInt8((Vector192*)ptr));
-								break;
-							case ValueType.ArrayInt16:
-								ptr = Pin(NativeMethods.ConstructVectorInt16((short[])paramValue), ref arena, size);
-								defer.Add(() => NativeMethods.DestroyVectorInt16((Vector192*)ptr));
-								break;
-							case ValueType.ArrayInt32:
-								ptr = Pin(NativeMethods.ConstructVectorInt32((int[])paramValue), ref arena, size);
-								defer.Add(() => NativeMethods.DestroyVectorInt32((Vector192*)ptr));
-								break;
-							case ValueType.ArrayInt64:
-								ptr = Pin(NativeMethods.ConstructVectorInt64((long[])paramValue), ref arena, size);
-								defer.Add(() => NativeMethods.DestroyVectorInt64((Vector192*)ptr));
-								break;
-							case ValueType.ArrayUInt8:
-								ptr = Pin(NativeMethods.ConstructVectorUInt8((byte[])paramValue), ref arena, size);
-								defer.Add(() => NativeMethods.DestroyVectorUInt8((Vector192*)ptr));
-								break;
-							case ValueType.ArrayUInt16:
-								ptr = Pin(NativeMethods.ConstructVectorUInt16((ushort[])paramValue), ref arena, size);
-								defer.Add(() => NativeMethods.DestroyVectorUInt16((Vector192*)ptr));
-								break;
-							case ValueType.ArrayUInt32:
-								ptr = Pin(NativeMethods.ConstructVectorUInt32((uint[])paramValue), ref arena, size);
-								defer.Add(() => NativeMethods.DestroyVectorUInt32((Vector192*)ptr));
-								break;
-							case ValueType.ArrayUInt64:
-								ptr = Pin(NativeMethods.ConstructVectorUInt64((ulong[])paramValue), ref arena, size);
-								defer.Add(() => NativeMethods.DestroyVectorUInt64((Vector192*)ptr));
-								break;
-							case ValueType.ArrayPointer:
-								ptr = Pin(NativeMethods.ConstructVectorIntPtr((nint[])paramValue), ref arena, size);
-								defer.Add(() => NativeMethods.DestroyVectorIntPtr((Vector192*)ptr));
-								break;
-							case ValueType.ArrayFloat:
-								ptr = Pin(NativeMethods.ConstructVectorFloat((float[])paramValue), ref arena, size);
-								defer.Add(() => NativeMethods.DestroyVectorFloat((Vector192*)ptr));
-								break;
-							case ValueType.ArrayDouble:
-								ptr = Pin(NativeMethods.ConstructVectorDouble((double[])paramValue), ref arena, size);
-								defer.Add(() => NativeMethods.DestroyVectorDouble((Vector192*)ptr));
-								break;
-							case ValueType.ArrayString:
-								ptr = Pin(NativeMethods.ConstructVectorString((string[])paramValue), ref arena, size);
-								defer.Add(() => NativeMethods.DestroyVectorString((Vector192*)ptr));
-								break;
-							case ValueType.ArrayAny:
-								ptr = Pin(NativeMethods.ConstructVectorVariant((object[])paramValue), ref arena, size);
-								defer.Add(() => NativeMethods.DestroyVectorVariant((Vector192*)ptr));
-								break;
-							case ValueType.ArrayVector2:
-								ptr = Pin(NativeMethods.ConstructVectorVector2((Vector2[])paramValue), ref arena, size);
-								defer.Add(() => NativeMethods.DestroyVectorVector2((Vector192*)ptr));
-								break;
-							case ValueType.ArrayVector3:
-								ptr = Pin(NativeMethods.ConstructVectorVector3((Vector3[])paramValue), ref arena, size);
-								defer.Add(() => NativeMethods.DestroyVectorVector3((Vector192*)ptr));
-								break;
-							case ValueType.ArrayVector4:
-								ptr = Pin(NativeMethods.ConstructVectorVector4((Vector4[])paramValue), ref arena, size);
-								defer.Add(() => NativeMethods.DestroyVectorVector4((Vector192*)ptr));
-								break;
-							case ValueType.ArrayMatrix4x4:
-								ptr = Pin(NativeMethods.ConstructVectorMatrix4x4((Matrix4x4[])paramValue), ref arena, size);
-								defer.Add(() => NativeMethods.DestroyVectorMatrix4x4((Vector192*)ptr));
-								break;
-							default:
-								throw new TypeNotFoundException($"Parameter '{parameterTypes[i].ValueType}' uses not supported type for marshalling!");
-						}
-					}
-
-					@params[index++] = (ulong)ptr;
-				}
-
-				jit.Function(@params, @return);
-
-				switch (retType)
-				{
-					case ValueType.Void:
-						break;
-					case ValueType.Bool:
-						ret = *(Bool8*)@return;
-						break;
-					case ValueType.Char8:
-						ret = *(Char8*)@return;
-						break;
-					case ValueType.Char16:
-						ret = *(Char16*)@return;
-						break;
-					case ValueType.Int8:
-						ret = *(sbyte*)@return;
-						break;
-					case ValueType.Int16:
-						ret = *(short*)@return;
-						break;
-					case ValueType.Int32:
-						ret = *(int*)@return;
-						break;
-					case ValueType.Int64:
-						ret = *(long*)@return;
-						break;
-					case ValueType.UInt8:
-						ret = *(byte*)@return;
-						break;
-					case ValueType.UInt16:
-						ret = *(ushort*)@return;
-						break;
-					case ValueType.UInt32:
-						ret = *(uint*)@return;
-						break;
-					case ValueType.UInt64:
-						ret = *(ulong*)@return;
-						break;
-					case ValueType.Pointer:
-						ret = *(nint*)@return;
-						break;
-					case ValueType.Float:
-						ret = *(float*)@return;
-						break;
-					case ValueType.Double:
-						ret = *(double*)@return;
-						break;
-					case ValueType.Function:
-						ret = GetDelegateForFunctionPointer(*(nint*)@return, methodInfo.ReturnType);
-						break;
-					case ValueType.Vector2:
-						ret = *(Vector2*)@return;
-						break;
-					case ValueType.Vector3:
-						if (hasRet)
-							ret = *(Vector3*)@return[0];
-						else
-							ret = *(Vector3*)@return;
-						break;
-					case ValueType.Vector4:
-						if (hasRet)
-							ret = *(Vector4*)@return[0];
-						else
-							ret = *(Vector4*)@return;
-						break;
-					case ValueType.Matrix4x4:
-						ret = *(Matrix4x4*)@return[0];
-						break;
-					case ValueType.String:
-						ret = NativeMethods.GetStringData((String192*)@return[0]);
-						break;
-					case ValueType.Any:
-						ret = NativeMethods.GetVariantData((Variant256*)@return[0]);
-						break;
-					case ValueType.ArrayBool:
-						ret = NativeMethods.GetVectorDataBool((Vector192*)@return[0]);
-						break;
-					case ValueType.ArrayChar8:
-						ret = NativeMethods.GetVectorDataChar8((Vector192*)@return[0]);
-						break;
-					case ValueType.ArrayChar16:
-						ret = NativeMethods.GetVectorDataChar16((Vector192*)@return[0]);
-						break;
-					case ValueType.ArrayInt8:
-						ret = NativeMethods.GetVectorDataInt8((Vector192*)@return[0]);
-						break;
-					case ValueType.ArrayInt16:
-						ret = NativeMethods.GetVectorDataInt16((Vector192*)@return[0]);
-						break;
-					case ValueType.ArrayInt32:
-						ret = NativeMethods.GetVectorDataInt32((Vector192*)@return[0]);
-						break;
-					case ValueType.ArrayInt64:
-						ret = NativeMethods.GetVectorDataInt64((Vector192*)@return[0]);
-						break;
-					case ValueType.ArrayUInt8:
-						ret = NativeMethods.GetVectorDataUInt8((Vector192*)@return[0]);
-						break;
-					case ValueType.ArrayUInt16:
-						ret = NativeMethods.GetVectorDataUInt16((Vector192*)@return[0]);
-						break;
-					case ValueType.ArrayUInt32:
-						ret = NativeMethods.GetVectorDataUInt32((Vector192*)@return[0]);
-						break;
-					case ValueType.ArrayUInt64:
-						ret = NativeMethods.GetVectorDataUInt64((Vector192*)@return[0]);
-						break;
-					case ValueType.ArrayPointer:
-						ret = NativeMethods.GetVectorDataIntPtr((Vector192*)@return[0]);
-						break;
-					case ValueType.ArrayFloat:
-						ret = NativeMethods.GetVectorDataFloat((Vector192*)@return[0]);
-						break;
-					case ValueType.ArrayDouble:
-						ret = NativeMethods.GetVectorDataDouble((Vector192*)@return[0]);
-						break;
-					case ValueType.ArrayString:
-						ret = NativeMethods.GetVectorDataString((Vector192*)@return[0]);
-						break;
-					case ValueType.ArrayAny:
-						ret = NativeMethods.GetVectorDataVariant((Vector192*)@return[0]);
-						break;
-					case ValueType.ArrayVector2:
-						ret = NativeMethods.GetVectorDataVector2((Vector192*)@return[0]);
-						break;
-					case ValueType.ArrayVector3:
-						ret = NativeMethods.GetVectorDataVector3((Vector192*)@return[0]);
-						break;
-					case ValueType.ArrayVector4:
-						ret = NativeMethods.GetVectorDataVector4((Vector192*)@return[0]);
-						break;
-					case ValueType.ArrayMatrix4x4:
-						ret = NativeMethods.GetVectorDataMatrix4x4((Vector192*)@return[0]);
-						break;
-					default:
-						throw new TypeNotFoundException($"Return '{returnType.ValueType}' uses not supported type for marshalling!");
-				}
-			}
-			finally
-			{
-				defer.Execute();
-			}
-
-			return ret!;
-		};
-
-		// old approach using GCHandles 
-		// TODO remove after testing new approach
-		/*return parameters =>
-		{
-			int index = 0, pin = 0, handle = 0;
-			GCHandle* pins = stackalloc GCHandle[paramCount];
-			(nint, ValueType)* handlers = stackalloc (nint, ValueType)[objectCount];
-			ulong* @params = stackalloc ulong[paramCount];
-			ulong* @return = stackalloc ulong[2]{ 0, 0 }; // 128bits to fit Vector4
-
-			object? ret = null;
-
-			nint Pin(ref object paramValue, ref GCHandle handle)
-			{
-				handle = GCHandle.Alloc(paramValue, GCHandleType.Pinned);
-				return handle.AddrOfPinnedObject();
-			}
-
-			ulong Raw<T>(T primitive) where T : unmanaged
-			{
-				return *(ulong*)(&primitive);
-			}
-
-			try
-			{
-				#region Allocate Memory for Return
-
-				ValueType retType = returnType.ValueType;
-				if (hasRet)
-				{
-					object obj;
-					switch (retType)
-					{
-						case ValueType.String:
-							obj = new String192();
-							break;
-						case ValueType.Any:
-							obj = new Variant256();
-							break;
-						case ValueType.ArrayBool:
-						case ValueType.ArrayChar8:
-						case ValueType.ArrayChar16:
-						case ValueType.ArrayInt8:
-						case ValueType.ArrayInt16:
-						case ValueType.ArrayInt32:
-						case ValueType.ArrayInt64:
-						case ValueType.ArrayUInt8:
-						case ValueType.ArrayUInt16:
-						case ValueType.ArrayUInt32:
-						case ValueType.ArrayUInt64:
-						case ValueType.ArrayPointer:
-						case ValueType.ArrayFloat:
-						case ValueType.ArrayDouble:
-						case ValueType.ArrayString:
-						case ValueType.ArrayAny:
-						case ValueType.ArrayVector2:
-						case ValueType.ArrayVector3:
-						case ValueType.ArrayVector4:
-						case ValueType.ArrayMatrix4x4:
-							obj = new Vector192();
-							break;
-						case ValueType.Vector2:
-							obj = new Vector2();
-							break;
-						case ValueType.Vector3:
-							obj = new Vector3();
-							break;
-						case ValueType.Vector4:
-							obj = new Vector4();
-							break;
-						case ValueType.Matrix4x4:
-							obj = new Matrix4x4();
-							break;
-						default:
-							throw new TypeNotFoundException();
-					}
-					nint ptr = Pin(ref obj, ref pins[pin++]);
-					handlers[handle++] = (ptr, retType);
-					@params[index++] = (ulong)ptr;
-				}
-
-				#endregion
-
-				#region Set Parameters
-
-				for (int i = 0; i < parameters.Length; i++)
-				{
-					object paramValue = parameters[i];
-					ManagedType paramType = parameterTypes[i];
-					ValueType valueType = paramType.ValueType;
-
-					if (paramType.IsByRef)
-					{
-						switch (valueType)
-						{
-							case ValueType.Bool:
-								@params[index++] = (ulong)Pin(ref paramValue, ref pins[pin++]);
-								break;
-							case ValueType.Char8:
-								@params[index++] = (ulong)Pin(ref paramValue, ref pins[pin++]);
-								break;
-							case ValueType.Char16:
-								@params[index++] = (ulong)Pin(ref paramValue, ref pins[pin++]);
-								break;
-							case ValueType.Int8:
-								@params[index++] = (ulong)Pin(ref paramValue, ref pins[pin++]);
-								break;
-							case ValueType.Int16:
-								@params[index++] = (ulong)Pin(ref paramValue, ref pins[pin++]);
-								break;
-							case ValueType.Int32:
-								@params[index++] = (ulong)Pin(ref paramValue, ref pins[pin++]);
-								break;
-							case ValueType.Int64:
-								@params[index++] = (ulong)Pin(ref paramValue, ref pins[pin++]);
-								break;
-							case ValueType.UInt8:
-								@params[index++] = (ulong)Pin(ref paramValue, ref pins[pin++]);
-								break;
-							case ValueType.UInt16:
-								@params[index++] = (ulong)Pin(ref paramValue, ref pins[pin++]);
-								break;
-							case ValueType.UInt32:
-								@params[index++] = (ulong)Pin(ref paramValue, ref pins[pin++]);
-								break;
-							case ValueType.UInt64:
-								@params[index++] = (ulong)Pin(ref paramValue, ref pins[pin++]);
-								break;
-							case ValueType.Pointer:
-								@params[index++] = (ulong)Pin(ref paramValue, ref pins[pin++]);
-								break;
-							case ValueType.Float:
-								@params[index++] = (ulong)Pin(ref paramValue, ref pins[pin++]);
-								break;
-							case ValueType.Double:
-								@params[index++] = (ulong)Pin(ref paramValue, ref pins[pin++]);
-								break;
-							case ValueType.Vector2:
-								@params[index++] = (ulong)Pin(ref paramValue, ref pins[pin++]);
-								break;
-							case ValueType.Vector3:
-								@params[index++] = (ulong)Pin(ref paramValue, ref pins[pin++]);
-								break;
-							case ValueType.Vector4:
-								@params[index++] = (ulong)Pin(ref paramValue, ref pins[pin++]);
-								break;
-							case ValueType.Matrix4x4:
-								@params[index++] = (ulong)Pin(ref paramValue, ref pins[pin++]);
-								break;
-							case ValueType.Function:
-							{
-								object ptr = GetFunctionPointerForDelegate((Delegate)paramValue);
-								@params[index++] = (ulong)Pin(ref ptr, ref pins[pin++]);
-								break;
-							}
-							case ValueType.String:
-							{
-								object tmp = NativeMethods.ConstructString((string)paramValue);
-								nint ptr = Pin(ref tmp, ref pins[pin++]);
-								handlers[handle++] = (ptr, valueType);
-								@params[index++] = (ulong)ptr;
-								break;
-							}
-							case ValueType.Any:
-							{
-								object tmp = NativeMethods.ConstructVariant(paramValue);
-								nint ptr = Pin(ref tmp, ref pins[pin++]);
-								handlers[handle++] = (ptr, valueType);
-								@params[index++] = (ulong)ptr;
-								break;
-							}
-							case ValueType.ArrayBool:
-							{
-								var arr = (Bool8[])paramValue;
-								object tmp = NativeMethods.ConstructVectorBool(arr, arr.Length);
-								nint ptr = Pin(ref tmp, ref pins[pin++]);
-								handlers[handle++] = (ptr, valueType);
-								@params[index++] = (ulong)ptr;
-								break;
-							}
-							case ValueType.ArrayChar8:
-							{
-								var arr = (Char8[])paramValue;
-								object tmp = NativeMethods.ConstructVectorChar8(arr, arr.Length);
-								nint ptr = Pin(ref tmp, ref pins[pin++]);
-								handlers[handle++] = (ptr, valueType);
-								@params[index++] = (ulong)ptr;
-								break;
-							}
-							case ValueType.ArrayChar16:
-							{
-								var arr = (Char16[])paramValue;
-								object tmp = NativeMethods.ConstructVectorChar16(arr, arr.Length);
-								nint ptr = Pin(ref tmp, ref pins[pin++]);
-								handlers[handle++] = (ptr, valueType);
-								@params[index++] = (ulong)ptr;
-								break;
-							}
-							case ValueType.ArrayInt8:
-							{
-								var arr = (sbyte[])paramValue;
-								object tmp = NativeMethods.ConstructVectorInt8(arr, arr.Length);
-								nint ptr = Pin(ref tmp, ref pins[pin++]);
-								handlers[handle++] = (ptr, valueType);
-								@params[index++] = (ulong)ptr;
-								break;
-							}
-							case ValueType.ArrayInt16:
-							{
-								var arr = (short[])paramValue;
-								object tmp = NativeMethods.ConstructVectorInt16(arr, arr.Length);
-								nint ptr = Pin(ref tmp, ref pins[pin++]);
-								handlers[handle++] = (ptr, valueType);
-								@params[index++] = (ulong)ptr;
-								break;
-							}
-							case ValueType.ArrayInt32:
-							{
-								var arr = (int[])paramValue;
-								object tmp = NativeMethods.ConstructVectorInt32(arr, arr.Length);
-								nint ptr = Pin(ref tmp, ref pins[pin++]);
-								handlers[handle++] = (ptr, valueType);
-								@params[index++] = (ulong)ptr;
-								break;
-							}
-							case ValueType.ArrayInt64:
-							{
-								var arr = (long[])paramValue;
-								object tmp = NativeMethods.ConstructVectorInt64(arr, arr.Length);
-								nint ptr = Pin(ref tmp, ref pins[pin++]);
-								handlers[handle++] = (ptr, valueType);
-								@params[index++] = (ulong)ptr;
-								break;
-							}
-							case ValueType.ArrayUInt8:
-							{
-								var arr = (byte[])paramValue;
-								object tmp = NativeMethods.ConstructVectorUInt8(arr, arr.Length);
-								nint ptr = Pin(ref tmp, ref pins[pin++]);
-								handlers[handle++] = (ptr, valueType);
-								@params[index++] = (ulong)ptr;
-								break;
-							}
-							case ValueType.ArrayUInt16:
-							{
-								var arr = (ushort[])paramValue;
-								object tmp = NativeMethods.ConstructVectorUInt16(arr, arr.Length);
-								nint ptr = Pin(ref tmp, ref pins[pin++]);
-								handlers[handle++] = (ptr, valueType);
-								@params[index++] = (ulong)ptr;
-								break;
-							}
-							case ValueType.ArrayUInt32:
-							{
-								var arr = (uint[])paramValue;
-								object tmp = NativeMethods.ConstructVectorUInt32(arr, arr.Length);
-								nint ptr = Pin(ref tmp, ref pins[pin++]);
-								handlers[handle++] = (ptr, valueType);
-								@params[index++] = (ulong)ptr;
-								break;
-							}
-							case ValueType.ArrayUInt64:
-							{
-								var arr = (ulong[])paramValue;
-								object tmp = NativeMethods.ConstructVectorUInt64(arr, arr.Length);
-								nint ptr = Pin(ref tmp, ref pins[pin++]);
-								handlers[handle++] = (ptr, valueType);
-								@params[index++] = (ulong)ptr;
-								break;
-							}
-							case ValueType.ArrayPointer:
-							{
-								var arr = (nint[])paramValue;
-								object tmp = NativeMethods.ConstructVectorIntPtr(arr, arr.Length);
-								nint ptr = Pin(ref tmp, ref pins[pin++]);
-								handlers[handle++] = (ptr, valueType);
-								@params[index++] = (ulong)ptr;
-								break;
-							}
-							case ValueType.ArrayFloat:
-							{
-								var arr = (float[])paramValue;
-								object tmp = NativeMethods.ConstructVectorFloat(arr, arr.Length);
-								nint ptr = Pin(ref tmp, ref pins[pin++]);
-								handlers[handle++] = (ptr, valueType);
-								@params[index++] = (ulong)ptr;
-								break;
-							}
-							case ValueType.ArrayDouble:
-							{
-								var arr = (double[])paramValue;
-								object tmp = NativeMethods.ConstructVectorDouble(arr, arr.Length);
-								nint ptr = Pin(ref tmp, ref pins[pin++]);
-								handlers[handle++] = (ptr, valueType);
-								@params[index++] = (ulong)ptr;
-								break;
-							}
-							case ValueType.ArrayString:
-							{
-								var arr = (string[])paramValue;
-								object tmp = NativeMethods.ConstructVectorString(arr, arr.Length);
-								nint ptr = Pin(ref tmp, ref pins[pin++]);
-								handlers[handle++] = (ptr, valueType);
-								@params[index++] = (ulong)ptr;
-								break;
-							}
-							case ValueType.ArrayAny:
-							{
-								var arr = (object?[])paramValue;
-								object tmp = NativeMethods.ConstructVectorVariant(arr, arr.Length);
-								nint ptr = Pin(ref tmp, ref pins[pin++]);
-								handlers[handle++] = (ptr, valueType);
-								@params[index++] = (ulong)ptr;
-								break;
-							}
-							case ValueType.ArrayVector2:
-							{
-								var arr = (Vector2[])paramValue;
-								object tmp = NativeMethods.ConstructVectorVector2(arr, arr.Length);
-								nint ptr = Pin(ref tmp, ref pins[pin++]);
-								handlers[handle++] = (ptr, valueType);
-								@params[index++] = (ulong)ptr;
-								break;
-							}
-							case ValueType.ArrayVector3:
-							{
-								var arr = (Vector3[])paramValue;
-								object tmp = NativeMethods.ConstructVectorVector3(arr, arr.Length);
-								nint ptr = Pin(ref tmp, ref pins[pin++]);
-								handlers[handle++] = (ptr, valueType);
-								@params[index++] = (ulong)ptr;
-								break;
-							}
-							case ValueType.ArrayVector4:
-							{
-								var arr = (Vector4[])paramValue;
-								object tmp = NativeMethods.ConstructVectorVector4(arr, arr.Length);
-								nint ptr = Pin(ref tmp, ref pins[pin++]);
-								handlers[handle++] = (ptr, valueType);
-								@params[index++] = (ulong)ptr;
-								break;
-							}
-							case ValueType.ArrayMatrix4x4:
-							{
-								var arr = (Matrix4x4[])paramValue;
-								object tmp = NativeMethods.ConstructVectorMatrix4x4(arr, arr.Length);
-								nint ptr = Pin(ref tmp, ref pins[pin++]);
-								handlers[handle++] = (ptr, valueType);
-								@params[index++] = (ulong)ptr;
-								break;
-							}
-							default:
-								throw new TypeNotFoundException($"Parameter '{parameterTypes[i].ValueType}' uses not supported type for marshalling!");
-						}
-					}
-					else
-					{
-						switch (valueType)
-						{
-							case ValueType.Bool:
-								@params[index++] = Raw((Bool8)paramValue);
-								break;
-							case ValueType.Char8:
-								@params[index++] = Raw((Char8)paramValue);
-								break;
-							case ValueType.Char16:
-								@params[index++] = Raw((Char16)paramValue);
-								break;
-							case ValueType.Int8:
-								@params[index++] = Raw((sbyte)paramValue);
-								break;
-							case ValueType.Int16:
-								@params[index++] = Raw((short)paramValue);
-								break;
-							case ValueType.Int32:
-								@params[index++] = Raw((int)paramValue);
-								break;
-							case ValueType.Int64:
-								@params[index++] = Raw((long)paramValue);
-								break;
-							case ValueType.UInt8:
-								@params[index++] = Raw((byte)paramValue);
-								break;
-							case ValueType.UInt16:
-								@params[index++] = Raw((ushort)paramValue);
-								break;
-							case ValueType.UInt32:
-								@params[index++] = Raw((uint)paramValue);
-								break;
-							case ValueType.UInt64:
-								@params[index++] = Raw((ulong)paramValue);
-								break;
-							case ValueType.Pointer:
-								@params[index++] = Raw((nint)paramValue);
-								break;
-							case ValueType.Float:
-								@params[index++] = Raw((float)paramValue);
-								break;
-							case ValueType.Double:
-								@params[index++] = Raw((double)paramValue);
-								break;
-							case ValueType.Vector2:
-								@params[index++] = (ulong)Pin(ref paramValue, ref pins[pin++]);
-								break;
-							case ValueType.Vector3:
-								@params[index++] = (ulong)Pin(ref paramValue, ref pins[pin++]);
-								break;
-							case ValueType.Vector4:
-								@params[index++] = (ulong)Pin(ref paramValue, ref pins[pin++]);
-								break;
-							case ValueType.Matrix4x4:
-								@params[index++] = (ulong)Pin(ref paramValue, ref pins[pin++]);
-								break;
-
-							case ValueType.Function:
-							{
-								object ptr = GetFunctionPointerForDelegate((Delegate)paramValue);
-								@params[index++] = (ulong)Pin(ref ptr, ref pins[pin++]);
-								break;
-							}
-							case ValueType.String:
-							{
-								object tmp = NativeMethods.ConstructString((string)paramValue);
-								nint ptr = Pin(ref tmp, ref pins[pin++]);
-								handlers[handle++] = (ptr, valueType);
-								@params[index++] = (ulong)ptr;
-								break;
-							}
-							case ValueType.Any:
-							{
-								object tmp = NativeMethods.ConstructVariant(paramValue);
-								nint ptr = Pin(ref tmp, ref pins[pin++]);
-								handlers[handle++] = (ptr, valueType);
-								@params[index++] = (ulong)ptr;
-								break;
-							}
-							case ValueType.ArrayBool:
-							{
-								var arr = (Bool8[])paramValue;
-								object tmp = NativeMethods.ConstructVectorBool(arr, arr.Length);
-								nint ptr = Pin(ref tmp, ref pins[pin++]);
-								handlers[handle++] = (ptr, valueType);
-								@params[index++] = (ulong)ptr;
-								break;
-							}
-							case ValueType.ArrayChar8:
-							{
-								var arr = (Char8[])paramValue;
-								object tmp = NativeMethods.ConstructVectorChar8(arr, arr.Length);
-								nint ptr = Pin(ref tmp, ref pins[pin++]);
-								handlers[handle++] = (ptr, valueType);
-								@params[index++] = (ulong)ptr;
-								break;
-							}
-							case ValueType.ArrayChar16:
-							{
-								var arr = (Char16[])paramValue;
-								object tmp = NativeMethods.ConstructVectorChar16(arr, arr.Length);
-								nint ptr = Pin(ref tmp, ref pins[pin++]);
-								handlers[handle++] = (ptr, valueType);
-								@params[index++] = (ulong)ptr;
-								break;
-							}
-							case ValueType.ArrayInt8:
-							{
-								var arr = (sbyte[])paramValue;
-								object tmp = NativeMethods.ConstructVectorInt8(arr, arr.Length);
-								nint ptr = Pin(ref tmp, ref pins[pin++]);
-								handlers[handle++] = (ptr, valueType);
-								@params[index++] = (ulong)ptr;
-								break;
-							}
-							case ValueType.ArrayInt16:
-							{
-								var arr = (short[])paramValue;
-								object tmp = NativeMethods.ConstructVectorInt16(arr, arr.Length);
-								nint ptr = Pin(ref tmp, ref pins[pin++]);
-								handlers[handle++] = (ptr, valueType);
-								@params[index++] = (ulong)ptr;
-								break;
-							}
-							case ValueType.ArrayInt32:
-							{
-								var arr = (int[])paramValue;
-								object tmp = NativeMethods.ConstructVectorInt32(arr, arr.Length);
-								nint ptr = Pin(ref tmp, ref pins[pin++]);
-								handlers[handle++] = (ptr, valueType);
-								@params[index++] = (ulong)ptr;
-								break;
-							}
-							case ValueType.ArrayInt64:
-							{
-								var arr = (long[])paramValue;
-								object tmp = NativeMethods.ConstructVectorInt64(arr, arr.Length);
-								nint ptr = Pin(ref tmp, ref pins[pin++]);
-								handlers[handle++] = (ptr, valueType);
-								@params[index++] = (ulong)ptr;
-								break;
-							}
-							case ValueType.ArrayUInt8:
-							{
-								var arr = (byte[])paramValue;
-								object tmp = NativeMethods.ConstructVectorUInt8(arr, arr.Length);
-								nint ptr = Pin(ref tmp, ref pins[pin++]);
-								handlers[handle++] = (ptr, valueType);
-								@params[index++] = (ulong)ptr;
-								break;
-							}
-							case ValueType.ArrayUInt16:
-							{
-								var arr = (ushort[])paramValue;
-								object tmp = NativeMethods.ConstructVectorUInt16(arr, arr.Length);
-								nint ptr = Pin(ref tmp, ref pins[pin++]);
-								handlers[handle++] = (ptr, valueType);
-								@params[index++] = (ulong)ptr;
-								break;
-							}
-							case ValueType.ArrayUInt32:
-							{
-								var arr = (uint[])paramValue;
-								object tmp = NativeMethods.ConstructVectorUInt32(arr, arr.Length);
-								nint ptr = Pin(ref tmp, ref pins[pin++]);
-								handlers[handle++] = (ptr, valueType);
-								@params[index++] = (ulong)ptr;
-								break;
-							}
-							case ValueType.ArrayUInt64:
-							{
-								var arr = (ulong[])paramValue;
-								object tmp = NativeMethods.ConstructVectorUInt64(arr, arr.Length);
-								nint ptr = Pin(ref tmp, ref pins[pin++]);
-								handlers[handle++] = (ptr, valueType);
-								@params[index++] = (ulong)ptr;
-								break;
-							}
-							case ValueType.ArrayPointer:
-							{
-								var arr = (nint[])paramValue;
-								object tmp = NativeMethods.ConstructVectorIntPtr(arr, arr.Length);
-								nint ptr = Pin(ref tmp, ref pins[pin++]);
-								handlers[handle++] = (ptr, valueType);
-								@params[index++] = (ulong)ptr;
-								break;
-							}
-							case ValueType.ArrayFloat:
-							{
-								var arr = (float[])paramValue;
-								object tmp = NativeMethods.ConstructVectorFloat(arr, arr.Length);
-								nint ptr = Pin(ref tmp, ref pins[pin++]);
-								handlers[handle++] = (ptr, valueType);
-								@params[index++] = (ulong)ptr;
-								break;
-							}
-							case ValueType.ArrayDouble:
-							{
-								var arr = (double[])paramValue;
-								object tmp = NativeMethods.ConstructVectorDouble(arr, arr.Length);
-								nint ptr = Pin(ref tmp, ref pins[pin++]);
-								handlers[handle++] = (ptr, valueType);
-								@params[index++] = (ulong)ptr;
-								break;
-							}
-							case ValueType.ArrayString:
-							{
-								var arr = (string[])paramValue;
-								object tmp = NativeMethods.ConstructVectorString(arr, arr.Length);
-								nint ptr = Pin(ref tmp, ref pins[pin++]);
-								handlers[handle++] = (ptr, valueType);
-								@params[index++] = (ulong)ptr;
-								break;
-							}
-							case ValueType.ArrayAny:
-							{
-								var arr = (object?[])paramValue;
-								object tmp = NativeMethods.ConstructVectorVariant(arr, arr.Length);
-								nint ptr = Pin(ref tmp, ref pins[pin++]);
-								handlers[handle++] = (ptr, valueType);
-								@params[index++] = (ulong)ptr;
-								break;
-							}
-							case ValueType.ArrayVector2:
-							{
-								var arr = (Vector2[])paramValue;
-								object tmp = NativeMethods.ConstructVectorVector2(arr, arr.Length);
-								nint ptr = Pin(ref tmp, ref pins[pin++]);
-								handlers[handle++] = (ptr, valueType);
-								@params[index++] = (ulong)ptr;
-								break;
-							}
-							case ValueType.ArrayVector3:
-							{
-								var arr = (Vector3[])paramValue;
-								object tmp = NativeMethods.ConstructVectorVector3(arr, arr.Length);
-								nint ptr = Pin(ref tmp, ref pins[pin++]);
-								handlers[handle++] = (ptr, valueType);
-								@params[index++] = (ulong)ptr;
-								break;
-							}
-							case ValueType.ArrayVector4:
-							{
-								var arr = (Vector4[])paramValue;
-								object tmp = NativeMethods.ConstructVectorVector4(arr, arr.Length);
-								nint ptr = Pin(ref tmp, ref pins[pin++]);
-								handlers[handle++] = (ptr, valueType);
-								@params[index++] = (ulong)ptr;
-								break;
-							}
-							case ValueType.ArrayMatrix4x4:
-							{
-								var arr = (Matrix4x4[])paramValue;
-								object tmp = NativeMethods.ConstructVectorMatrix4x4(arr, arr.Length);
-								nint ptr = Pin(ref tmp, ref pins[pin++]);
-								handlers[handle++] = (ptr, valueType);
-								@params[index++] = (ulong)ptr;
-								break;
-							}
-							default:
-								throw new TypeNotFoundException($"Parameter '{parameterTypes[i].ValueType}' uses not supported type for marshalling!");
-						}
-					}
-				}
-
-				#endregion
-
-				#region Call Function
-
-				call.Function(@params, @return);
-
-				switch (retType)
-				{
-					case ValueType.Void:
-						break;
-					case ValueType.Bool:
-						ret = *(Bool8*)@return;
-						break;
-					case ValueType.Char8:
-						ret = *(Char8*)@return;
-						break;
-					case ValueType.Char16:
-						ret = *(Char16*)@return;
-						break;
-					case ValueType.Int8:
-						ret = *(sbyte*)@return;
-						break;
-					case ValueType.Int16:
-						ret = *(short*)@return;
-						break;
-					case ValueType.Int32:
-						ret = *(int*)@return;
-						break;
-					case ValueType.Int64:
-						ret = *(long*)@return;
-						break;
-					case ValueType.UInt8:
-						ret = *(byte*)@return;
-						break;
-					case ValueType.UInt16:
-						ret = *(ushort*)@return;
-						break;
-					case ValueType.UInt32:
-						ret = *(uint*)@return;
-						break;
-					case ValueType.UInt64:
-						ret = *(ulong*)@return;
-						break;
-					case ValueType.Pointer:
-						ret = *(nint*)@return;
-						break;
-					case ValueType.Float:
-						ret = *(float*)@return;
-						break;
-					case ValueType.Double:
-						ret = *(double*)@return;
-						break;
-					case ValueType.Function:
-						ret = GetDelegateForFunctionPointer(*(nint*)@return, methodInfo.ReturnType);
-						break;
-					case ValueType.Vector2:
-						ret = *(Vector2*)@return;
-						break;
-					case ValueType.Vector3:
-						if (hasRet)
-							ret = *(Vector3*)@return[0];
-						else
-							ret = *(Vector3*)@return;
-						break;
-					case ValueType.Vector4:
-						if (hasRet)
-							ret = *(Vector4*)@return[0];
-						else
-							ret = *(Vector4*)@return;
-						break;
-					case ValueType.Matrix4x4:
-						ret = *(Matrix4x4*)@return[0];
-						break;
-					case ValueType.String:
-						ret = NativeMethods.GetStringData((String192*)@return[0]);
-						break;
-					case ValueType.Any:
-						ret = NativeMethods.GetVariantData((Variant256*)@return[0]);
-						break;
-					case ValueType.ArrayBool:
-						ret = NativeMethods.GetVectorDataBool((Vector192*)@return[0]);
-						break;
-					case ValueType.ArrayChar8:
-						ret = NativeMethods.GetVectorDataChar8((Vector192*)@return[0]);
-						break;
-					case ValueType.ArrayChar16:
-						ret = NativeMethods.GetVectorDataChar16((Vector192*)@return[0]);
-						break;
-					case ValueType.ArrayInt8:
-						ret = NativeMethods.GetVectorDataInt8((Vector192*)@return[0]);
-						break;
-					case ValueType.ArrayInt16:
-						ret = NativeMethods.GetVectorDataInt16((Vector192*)@return[0]);
-						break;
-					case ValueType.ArrayInt32:
-						ret = NativeMethods.GetVectorDataInt32((Vector192*)@return[0]);
-						break;
-					case ValueType.ArrayInt64:
-						ret = NativeMethods.GetVectorDataInt64((Vector192*)@return[0]);
-						break;
-					case ValueType.ArrayUInt8:
-						ret = NativeMethods.GetVectorDataUInt8((Vector192*)@return[0]);
-						break;
-					case ValueType.ArrayUInt16:
-						ret = NativeMethods.GetVectorDataUInt16((Vector192*)@return[0]);
-						break;
-					case ValueType.ArrayUInt32:
-						ret = NativeMethods.GetVectorDataUInt32((Vector192*)@return[0]);
-						break;
-					case ValueType.ArrayUInt64:
-						ret = NativeMethods.GetVectorDataUInt64((Vector192*)@return[0]);
-						break;
-					case ValueType.ArrayPointer:
-						ret = NativeMethods.GetVectorDataIntPtr((Vector192*)@return[0]);
-						break;
-					case ValueType.ArrayFloat:
-						ret = NativeMethods.GetVectorDataFloat((Vector192*)@return[0]);
-						break;
-					case ValueType.ArrayDouble:
-						ret = NativeMethods.GetVectorDataDouble((Vector192*)@return[0]);
-						break;
-					case ValueType.ArrayString:
-						ret = NativeMethods.GetVectorDataString((Vector192*)@return[0]);
-						break;
-					case ValueType.ArrayAny:
-						ret = NativeMethods.GetVectorDataVariant((Vector192*)@return[0]);
-						break;
-					case ValueType.ArrayVector2:
-						ret = NativeMethods.GetVectorDataVector2((Vector192*)@return[0]);
-						break;
-					case ValueType.ArrayVector3:
-						ret = NativeMethods.GetVectorDataVector3((Vector192*)@return[0]);
-						break;
-					case ValueType.ArrayVector4:
-						ret = NativeMethods.GetVectorDataVector4((Vector192*)@return[0]);
-						break;
-					case ValueType.ArrayMatrix4x4:
-						ret = NativeMethods.GetVectorDataMatrix4x4((Vector192*)@return[0]);
-						break;
-					default:
-						throw new TypeNotFoundException($"Return '{returnType.ValueType}' uses not supported type for marshalling!");
-				}
-
-				#endregion
-
-				#region Pull Refererences Back
-
-				if (hasRefs)
-				{
-					int j = hasRet ? 1 : 0; // skip first param if has return
-
-					if (j < handle)
-					{
-						for (int i = 0; i < parameters.Length; i++)
-						{
-							//object paramValue = parameters[i];
-							ManagedType paramType = parameterTypes[i];
-							if (paramType.IsByRef)
-							{
-								switch (paramType.ValueType)
-								{
-									case ValueType.String:
-										parameters[i] = NativeMethods.GetStringData((String192*)handlers[j++].Item1);
-										break;
-									case ValueType.Any:
-										parameters[i] = NativeMethods.GetVariantData((Variant256*)handlers[j++].Item1)!;
-										break;
-									case ValueType.ArrayBool:
-										parameters[i] = NativeMethods.GetVectorDataBool((Vector192*)handlers[j++].Item1);
-										break;
-									case ValueType.ArrayChar8:
-										parameters[i] = NativeMethods.GetVectorDataChar8((Vector192*)handlers[j++].Item1);
-										break;
-									case ValueType.ArrayChar16:
-										parameters[i] = NativeMethods.GetVectorDataChar16((Vector192*)handlers[j++].Item1);
-										break;
-									case ValueType.ArrayInt8:
-										parameters[i] = NativeMethods.GetVectorDataInt8((Vector192*)handlers[j++].Item1);
-										break;
-									case ValueType.ArrayInt16:
-										parameters[i] = NativeMethods.GetVectorDataInt16((Vector192*)handlers[j++].Item1);
-										break;
-									case ValueType.ArrayInt32:
-										parameters[i] = NativeMethods.GetVectorDataInt32((Vector192*)handlers[j++].Item1);
-										break;
-									case ValueType.ArrayInt64:
-										parameters[i] = NativeMethods.GetVectorDataInt64((Vector192*)handlers[j++].Item1);
-										break;
-									case ValueType.ArrayUInt8:
-										parameters[i] = NativeMethods.GetVectorDataUInt8((Vector192*)handlers[j++].Item1);
-										break;
-									case ValueType.ArrayUInt16:
-										parameters[i] = NativeMethods.GetVectorDataUInt16((Vector192*)handlers[j++].Item1);
-										break;
-									case ValueType.ArrayUInt32:
-										parameters[i] = NativeMethods.GetVectorDataUInt32((Vector192*)handlers[j++].Item1);
-										break;
-									case ValueType.ArrayUInt64:
-										parameters[i] = NativeMethods.GetVectorDataUInt64((Vector192*)handlers[j++].Item1);
-										break;
-									case ValueType.ArrayPointer:
-										parameters[i] = NativeMethods.GetVectorDataIntPtr((Vector192*)handlers[j++].Item1);
-										break;
-									case ValueType.ArrayFloat:
-										parameters[i] = NativeMethods.GetVectorDataFloat((Vector192*)handlers[j++].Item1);
-										break;
-									case ValueType.ArrayDouble:
-										parameters[i] =  NativeMethods.GetVectorDataDouble((Vector192*)handlers[j++].Item1);
-										break;
-									case ValueType.ArrayString:
-										parameters[i] = NativeMethods.GetVectorDataString((Vector192*)handlers[j++].Item1);
-										break;
-									case ValueType.ArrayAny:
-										parameters[i] = NativeMethods.GetVectorDataVariant((Vector192*)handlers[j++].Item1);
-										break;
-									case ValueType.ArrayVector2:
-										parameters[i] = NativeMethods.GetVectorDataVector2((Vector192*)handlers[j++].Item1);
-										break;
-									case ValueType.ArrayVector3:
-										parameters[i] = NativeMethods.GetVectorDataVector3((Vector192*)handlers[j++].Item1);
-										break;
-									case ValueType.ArrayVector4:
-										parameters[i] = NativeMethods.GetVectorDataVector4((Vector192*)handlers[j++].Item1);
-										break;
-									case ValueType.ArrayMatrix4x4:
-										parameters[i] = NativeMethods.GetVectorDataMatrix4x4((Vector192*)handlers[j++].Item1);
-										break;
-								}
-							}
-
-							if (j >= handle)
-								break;
-						}
-					}
-				}
-				#endregion
-
-			}
-
-			#region Cleanup Temp Storage
-
-			finally
-			{
-				for (int i = 0; i < handle; i++)
-				{
-					var (ptr, type) = handlers[i];
-					switch (type)
-					{
-						case ValueType.Vector2:
-						case ValueType.Vector3:
-						case ValueType.Vector4:
-						case ValueType.Matrix4x4:
-							// no dtor
-							break;
-						case ValueType.String:
-							NativeMethods.DestroyString((String192*)ptr);
-							break;
-						case ValueType.Any:
-							NativeMethods.DestroyVariant((Variant256*)ptr);
-							break;
-						case ValueType.ArrayBool:
-							NativeMethods.DestroyVectorBool((Vector192*)ptr);
-							break;
-						case ValueType.ArrayChar8:
-							NativeMethods.DestroyVectorChar8((Vector192*)ptr);
-							break;
-						case ValueType.ArrayChar16:
-							NativeMethods.DestroyVectorChar16((Vector192*)ptr);
-							break;
-						case ValueType.ArrayInt8:
-							NativeMethods.DestroyVectorInt8((Vector192*)ptr);
-							break;
-						case ValueType.ArrayInt16:
-							NativeMethods.DestroyVectorInt16((Vector192*)ptr);
-							break;
-						case ValueType.ArrayInt32:
-							NativeMethods.DestroyVectorInt32((Vector192*)ptr);
-							break;
-						case ValueType.ArrayInt64:
-							NativeMethods.DestroyVectorInt64((Vector192*)ptr);
-							break;
-						case ValueType.ArrayUInt8:
-							NativeMethods.DestroyVectorUInt8((Vector192*)ptr);
-							break;
-						case ValueType.ArrayUInt16:
-							NativeMethods.DestroyVectorUInt16((Vector192*)ptr);
-							break;
-						case ValueType.ArrayUInt32:
-							NativeMethods.DestroyVectorUInt32((Vector192*)ptr);
-							break;
-						case ValueType.ArrayUInt64:
-							NativeMethods.DestroyVectorUInt64((Vector192*)ptr);
-							break;
-						case ValueType.ArrayPointer:
-							NativeMethods.DestroyVectorIntPtr((Vector192*)ptr);
-							break;
-						case ValueType.ArrayFloat:
-							NativeMethods.DestroyVectorFloat((Vector192*)ptr);
-							break;
-						case ValueType.ArrayDouble:
-							NativeMethods.DestroyVectorDouble((Vector192*)ptr);
-							break;
-						case ValueType.ArrayString:
-							NativeMethods.DestroyVectorString((Vector192*)ptr);
-							break;
-						case ValueType.ArrayAny:
-							NativeMethods.DestroyVectorVariant((Vector192*)ptr);
-							break;
-						case ValueType.ArrayVector2:
-							NativeMethods.DestroyVectorVector2((Vector192*)ptr);
-							break;
-						case ValueType.ArrayVector3:
-							NativeMethods.DestroyVectorVector3((Vector192*)ptr);
-							break;
-						case ValueType.ArrayVector4:
-							NativeMethods.DestroyVectorVector4((Vector192*)ptr);
-							break;
-						case ValueType.ArrayMatrix4x4:
-							NativeMethods.DestroyVectorMatrix4x4((Vector192*)ptr);
-							break;
-						default:
-							throw new TypeNotFoundException();
-					}
-				}
-
-				for (int i = 0; i < pin; ++i)
-				{
-					pins[i].Free();
-				}
-			}
-
-			#endregion
-
-			return ret!;
-		};*/
+		return DelegateHelpers.CreateExternalInvoker(delegateType, jit, (nint)jit.Function, hasRet, $"0x{funcAddress:X}");
 	}
 
 	public static nint GetFunctionPointerForDelegate(Delegate d)
@@ -0,0 +1,171 @@
+using System.Reflection;
+using System.Runtime.InteropServices;
+
+namespace Plugify;
+
+using static ManagedHost;
+
+/// <summary>
+/// Entry of the export table generated by Plugify.Generators for [NativeExport] methods.
+/// The signature hash lets the language module refuse a stub that no longer matches the plugin manifest.
+/// </summary>
+public readonly struct NativeExportEntry(string name, nint function, ulong signature)
+{
+    public string Name { get; } = name;
+    public nint Function { get; } = function;
+    public ulong Signature { get; } = signature;
+}
+
+public static class NativeExports
+{
+    private const string ExportTableType = "Plugify.Generated.PlugifyExports";
+    private const string ExportTableMethod = "GetExports";
+
+    /// <summary>
+    /// Reports an exception thrown by an export that was called from native code.
+    /// </summary>
+    public static void HandleException(Exception exception) => ManagedHost.HandleException(exception);
+
+    [UnmanagedCallersOnly]
+    internal static unsafe void GetAssemblyExports(Guid assemblyId, NativeString* funcNames, nint* functions, ulong* signatures, int count)
+    {
+        try
+        {
+            new Span<nint>(functions, count).Clear();
+            new Span<ulong>(signatures, count).Clear();
+
+            if (!AssemblyLoader.TryGetAssembly(assemblyId, out var wrapper) || !wrapper.Assembly.TryGetTarget(out var assembly))
+            {
+                LogMessage($"Cannot find assembly '{assemblyId}'.", MessageLevel.Error);
+                return;
+            }
+
+            // Plugins built without the generator (or without unsafe code) have no table
+            var getExports = assembly.GetType(ExportTableType)?.GetMethod(ExportTableMethod, BindingFlags.Static | BindingFlags.Public | BindingFlags.NonPublic);
+            if (getExports?.Invoke(null, null) is not NativeExportEntry[] entries)
+            {
+                return;
+            }
+
+            var table = new Dictionary<string, NativeExportEntry>(entries.Length);
+            foreach (var entry in entries)
+            {
+                table[entry.Name] = entry;
+            }
+
+            for (int i = 0; i < count; i++)
+            {
+                string? funcName = funcNames[i];
+                if (funcName != null && table.TryGetValue(funcName, out var entry))
+                {
+                    functions[i] = entry.Function;
+                    signatures[i] = entry.Signature;
+                }
+            }
+        }
+        catch (Exception e)
+        {
+            HandleException(e);
+        }
+    }
+
+    private static bool TryGetManifestModule(Guid assemblyId, out Module module)
+    {
+        module = null!;
+        if (!AssemblyLoader.TryGetAssembly(assemblyId, out var wrapper) || !wrapper.Assembly.TryGetTarget(out var assembly))
+        {
+            LogMessage($"Cannot find assembly '{assemblyId}'.", MessageLevel.Error);
+            return false;
+        }
+
+        module = assembly.ManifestModule;
+        return true;
+    }
+
+    [UnmanagedCallersOnly]
+    internal static unsafe void GetAssemblyModuleVersionId(Guid assemblyId, Guid* outMvid)
+    {
+        try
+        {
+            *outMvid = TryGetManifestModule(assemblyId, out var module) ? module.ModuleVersionId : Guid.Empty;
+        }
+        catch (Exception e)
+        {
+            HandleException(e);
+        }
+    }
+
+    // Tokens only identify a member within its own module, members declared in other assemblies get 0
+    [UnmanagedCallersOnly]
+    internal static int GetTypeMetadataToken(Guid assemblyId, nint typeHandle)
+    {
+        try
+        {
+            if (!TryGetManifestModule(assemblyId, out var module) || !TypeInterface.CachedTypes.TryGetValue(typeHandle, out var type))
+                return 0;
+
+            return type.Module == module ? type.MetadataToken : 0;
+        }
+        catch (Exception e)
+        {
+            HandleException(e);
+            return 0;
+        }
+    }
+
+    [UnmanagedCallersOnly]
+    internal static int GetMethodInfoMetadataToken(Guid assemblyId, nint methodHandle)
+    {
+        try
+        {
+            if (!TryGetManifestModule(assemblyId, out var module) || !TypeInterface.CachedMethods.TryGetValue(methodHandle, out var method))
+                return 0;
+
+            return method.Module == module ? method.MetadataToken : 0;
+        }
+        catch (Exception e)
+        {
+            HandleException(e);
+            return 0;
+        }
+    }
+
+    // Turns tokens saved by the native export cache back into type/method handles, 0 stays 0
+    [UnmanagedCallersOnly]
+    internal static unsafe Bool32 ResolveMetadataTokens(Guid assemblyId, int* tokens, nint* outHandles, int count)
+    {
+        try
+        {
+            new Span<nint>(outHandles, count).Clear();
+
+            if (!TryGetManifestModule(assemblyId, out var module))
+                return false;
+
+            for (int i = 0; i < count; i++)
+            {
+                if (tokens[i] == 0)
+                    continue;
+
+                switch (module.ResolveMember(tokens[i]))
+                {
+                    case Type type:
+                        outHandles[i] = TypeInterface.CachedTypes.Add(type);
+                        break;
+                    case MethodInfo method:
+                        outHandles[i] = TypeInterface.CachedMethods.Add(method);
+                        break;
+                    default:
+                        return false;
+                }
+            }
+
+            return true;
+        }
+        catch (Exception e)
+        {
+            // A stale token must not take the plugin down, the caller falls back to a full lookup
+            LogMessage($"Failed to resolve cached metadata tokens: {e.Message}", MessageLevel.Warning);
+            return false;
+        }
+    }
+}
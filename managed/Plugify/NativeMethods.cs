@@ -1,7 +1,9 @@
-﻿using System.Numerics;
+﻿using System.Buffers;
+using System.Numerics;
 using System.Runtime.CompilerServices;
 using System.Runtime.InteropServices;
 using System.Runtime.InteropServices.Marshalling;
+using System.Text;
 
 namespace Plugify;
     
@@ -57,21 +59,126 @@ public static unsafe partial class NativeMethods
     [SuppressGCTransition]
     public static partial int GetStringLength(String192* str);
 
-    [LibraryImport(DllName, StringMarshalling = StringMarshalling.Utf8)]
+    [LibraryImport(DllName)]
     [SuppressGCTransition]
-    public static partial string GetStringData(String192* str);
+    public static partial byte* GetStringPointer(String192* str);
 
-    [LibraryImport(DllName, StringMarshalling = StringMarshalling.Utf8)]
+    // Decoded straight from the native buffer, without a temporary copy of it
+    public static string GetStringData(String192* str)
+    {
+        int length = GetStringLength(str);
+        return length == 0 ? string.Empty : Encoding.UTF8.GetString(GetStringPointer(str), length);
+    }
+
+    public static ReadOnlySpan<byte> GetStringSpan(String192* str) => new(GetStringPointer(str), GetStringLength(str));
+
+    [LibraryImport(DllName)]
     [SuppressGCTransition]
-    public static partial String192 ConstructString(string? source);
+    public static partial String192 ConstructString(byte* source, int length);
+
+    public static String192 ConstructString(string? source)
+    {
+        if (string.IsNullOrEmpty(source))
+            return ConstructString(null, 0);
+
+        byte[]? rented = null;
+        try
+        {
+            Span<byte> utf8 = EncodeUtf8(source, stackalloc byte[Utf8StackLimit], ref rented);
+            fixed (byte* ptr = utf8)
+            {
+                return ConstructString(ptr, utf8.Length);
+            }
+        }
+        finally
+        {
+            if (rented != null)
+                ArrayPool<byte>.Shared.Return(rented);
+        }
+    }
     
     [LibraryImport(DllName)]
     [SuppressGCTransition]
     public static partial void DestroyString(String192* str);
 
-    [LibraryImport(DllName, StringMarshalling = StringMarshalling.Utf8)]
+    [LibraryImport(DllName)]
     [SuppressGCTransition]
-    public static partial void AssignString(String192* str, string? source);
+    public static partial void AssignString(String192* str, byte* source, int length);
+
+    public static void AssignString(String192* str, string? source)
+    {
+        if (string.IsNullOrEmpty(source))
+        {
+            AssignString(str, null, 0);
+            return;
+        }
+
+        byte[]? rented = null;
+        try
+        {
+            Span<byte> utf8 = EncodeUtf8(source, stackalloc byte[Utf8StackLimit], ref rented);
+            fixed (byte* ptr = utf8)
+            {
+                AssignString(str, ptr, utf8.Length);
+            }
+        }
+        finally
+        {
+            if (rented != null)
+                ArrayPool<byte>.Shared.Return(rented);
+        }
+    }
+
+    // Strings go to the natives as UTF-8 bytes with their length, encoded on the stack (or in a pooled
+    // buffer past the limit) and copied once into the plg::string, embedded NULs included
+    private const int Utf8StackLimit = 512;
+
+    private static Span<byte> EncodeUtf8(string source, Span<byte> buffer, ref byte[]? rented)
+    {
+        int maxLength = Encoding.UTF8.GetMaxByteCount(source.Length);
+        if (maxLength > buffer.Length)
+        {
+            rented = ArrayPool<byte>.Shared.Rent(maxLength);
+            buffer = rented;
+        }
+
+        return buffer[..Encoding.UTF8.GetBytes(source, buffer)];
+    }
+
+    // String arrays go packed into one UTF-8 blob, element i spans [Offsets[i], Offsets[i + 1]),
+    // both held in pooled buffers instead of a native copy per element
+    private readonly struct PackedStrings : IDisposable
+    {
+        public readonly byte[] Data;
+        public readonly int[] Offsets;
+
+        public PackedStrings(string?[] arr, int len)
+        {
+            int byteCount = 0;
+            for (int i = 0; i < len; i++)
+            {
+                byteCount += Encoding.UTF8.GetByteCount(arr[i] ?? string.Empty);
+            }
+
+            // Never empty, so fixed always yields a valid pointer
+            Data = ArrayPool<byte>.Shared.Rent(Math.Max(byteCount, 1));
+            Offsets = ArrayPool<int>.Shared.Rent(len + 1);
+
+            int offset = 0;
+            for (int i = 0; i < len; i++)
+            {
+                Offsets[i] = offset;
+                offset += Encoding.UTF8.GetBytes(arr[i] ?? string.Empty, Data.AsSpan(offset));
+            }
+            Offsets[len] = offset;
+        }
+
+        public void Dispose()
+        {
+            ArrayPool<byte>.Shared.Return(Data);
+            ArrayPool<int>.Shared.Return(Offsets);
+        }
+    }
 
     #endregion
     
@@ -520,7 +627,49 @@ public static unsafe partial class NativeMethods
 
 	[LibraryImport(DllName)]
 	[SuppressGCTransition]
-	public static partial void GetVectorDataString(Vector192* vec, [MarshalAs(UnmanagedType.LPArray, ArraySubType = UnmanagedType.LPStr)] [In, Out] string[] arr);
+	public static partial int GetVectorDataString(Vector192* vec, byte* data, int capacity, int* offsets);
+
+	public static void GetVectorDataString(Vector192* vec, [In, Out] string[] arr)
+	{
+		int len = GetVectorSizeString(vec);
+		if (len == 0)
+			return;
+
+		// One native call copies every element, a second one only when the guessed size was too small
+		int[] offsets = ArrayPool<int>.Shared.Rent(len + 1);
+		byte[] data = ArrayPool<byte>.Shared.Rent(len * 32);
+		try
+		{
+			int byteCount;
+			fixed (int* offsetsPtr = offsets)
+			{
+				fixed (byte* dataPtr = data)
+				{
+					byteCount = GetVectorDataString(vec, dataPtr, data.Length, offsetsPtr);
+				}
+
+				if (byteCount > data.Length)
+				{
+					ArrayPool<byte>.Shared.Return(data);
+					data = ArrayPool<byte>.Shared.Rent(byteCount);
+					fixed (byte* dataPtr = data)
+					{
+						GetVectorDataString(vec, dataPtr, data.Length, offsetsPtr);
+					}
+				}
+			}
+
+			for (int i = 0; i < len; i++)
+			{
+				arr[i] = Encoding.UTF8.GetString(data, offsets[i], offsets[i + 1] - offsets[i]);
+			}
+		}
+		finally
+		{
+			ArrayPool<byte>.Shared.Return(data);
+			ArrayPool<int>.Shared.Return(offsets);
+		}
+	}
 
 	[LibraryImport(DllName)]
 	[SuppressGCTransition]
@@ -694,6 +843,186 @@ public static unsafe partial class NativeMethods
 	
 	#endregion
 
+	#region GetVectorSpan functions
+
+	// Views over the native buffer instead of a copy, only valid while the vector is neither resized nor destroyed
+
+	[LibraryImport(DllName)]
+	[SuppressGCTransition]
+	public static partial Char8* GetVectorPointerChar8(Vector192* vec);
+
+	[LibraryImport(DllName)]
+	[SuppressGCTransition]
+	public static partial Char16* GetVectorPointerChar16(Vector192* vec);
+
+	[LibraryImport(DllName)]
+	[SuppressGCTransition]
+	public static partial sbyte* GetVectorPointerInt8(Vector192* vec);
+
+	[LibraryImport(DllName)]
+	[SuppressGCTransition]
+	public static partial short* GetVectorPointerInt16(Vector192* vec);
+
+	[LibraryImport(DllName)]
+	[SuppressGCTransition]
+	public static partial int* GetVectorPointerInt32(Vector192* vec);
+
+	[LibraryImport(DllName)]
+	[SuppressGCTransition]
+	public static partial long* GetVectorPointerInt64(Vector192* vec);
+
+	[LibraryImport(DllName)]
+	[SuppressGCTransition]
+	public static partial byte* GetVectorPointerUInt8(Vector192* vec);
+
+	[LibraryImport(DllName)]
+	[SuppressGCTransition]
+	public static partial ushort* GetVectorPointerUInt16(Vector192* vec);
+
+	[LibraryImport(DllName)]
+	[SuppressGCTransition]
+	public static partial uint* GetVectorPointerUInt32(Vector192* vec);
+
+	[LibraryImport(DllName)]
+	[SuppressGCTransition]
+	public static partial ulong* GetVectorPointerUInt64(Vector192* vec);
+
+	[LibraryImport(DllName)]
+	[SuppressGCTransition]
+	public static partial nint* GetVectorPointerIntPtr(Vector192* vec);
+
+	[LibraryImport(DllName)]
+	[SuppressGCTransition]
+	public static partial float* GetVectorPointerFloat(Vector192* vec);
+
+	[LibraryImport(DllName)]
+	[SuppressGCTransition]
+	public static partial double* GetVectorPointerDouble(Vector192* vec);
+
+	[LibraryImport(DllName)]
+	[SuppressGCTransition]
+	public static partial Vector2* GetVectorPointerVector2(Vector192* vec);
+
+	[LibraryImport(DllName)]
+	[SuppressGCTransition]
+	public static partial Vector3* GetVectorPointerVector3(Vector192* vec);
+
+	[LibraryImport(DllName)]
+	[SuppressGCTransition]
+	public static partial Vector4* GetVectorPointerVector4(Vector192* vec);
+
+	[LibraryImport(DllName)]
+	[SuppressGCTransition]
+	public static partial Matrix4x4* GetVectorPointerMatrix4x4(Vector192* vec);
+
+	public static Span<Char8> GetVectorSpanChar8(Vector192* vec) => new(GetVectorPointerChar8(vec), GetVectorSizeChar8(vec));
+
+	public static Span<Char16> GetVectorSpanChar16(Vector192* vec) => new(GetVectorPointerChar16(vec), GetVectorSizeChar16(vec));
+
+	public static Span<sbyte> GetVectorSpanInt8(Vector192* vec) => new(GetVectorPointerInt8(vec), GetVectorSizeInt8(vec));
+
+	public static Span<short> GetVectorSpanInt16(Vector192* vec) => new(GetVectorPointerInt16(vec), GetVectorSizeInt16(vec));
+
+	public static Span<int> GetVectorSpanInt32(Vector192* vec) => new(GetVectorPointerInt32(vec), GetVectorSizeInt32(vec));
+
+	public static Span<long> GetVectorSpanInt64(Vector192* vec) => new(GetVectorPointerInt64(vec), GetVectorSizeInt64(vec));
+
+	public static Span<byte> GetVectorSpanUInt8(Vector192* vec) => new(GetVectorPointerUInt8(vec), GetVectorSizeUInt8(vec));
+
+	public static Span<ushort> GetVectorSpanUInt16(Vector192* vec) => new(GetVectorPointerUInt16(vec), GetVectorSizeUInt16(vec));
+
+	public static Span<uint> GetVectorSpanUInt32(Vector192* vec) => new(GetVectorPointerUInt32(vec), GetVectorSizeUInt32(vec));
+
+	public static Span<ulong> GetVectorSpanUInt64(Vector192* vec) => new(GetVectorPointerUInt64(vec), GetVectorSizeUInt64(vec));
+
+	public static Span<nint> GetVectorSpanIntPtr(Vector192* vec) => new(GetVectorPointerIntPtr(vec), GetVectorSizeIntPtr(vec));
+
+	public static Span<float> GetVectorSpanFloat(Vector192* vec) => new(GetVectorPointerFloat(vec), GetVectorSizeFloat(vec));
+
+	public static Span<double> GetVectorSpanDouble(Vector192* vec) => new(GetVectorPointerDouble(vec), GetVectorSizeDouble(vec));
+
+	public static Span<Vector2> GetVectorSpanVector2(Vector192* vec) => new(GetVectorPointerVector2(vec), GetVectorSizeVector2(vec));
+
+	public static Span<Vector3> GetVectorSpanVector3(Vector192* vec) => new(GetVectorPointerVector3(vec), GetVectorSizeVector3(vec));
+
+	public static Span<Vector4> GetVectorSpanVector4(Vector192* vec) => new(GetVectorPointerVector4(vec), GetVectorSizeVector4(vec));
+
+	public static Span<Matrix4x4> GetVectorSpanMatrix4x4(Vector192* vec) => new(GetVectorPointerMatrix4x4(vec), GetVectorSizeMatrix4x4(vec));
+
+	#endregion
+
+	#region ResizeVector functions
+
+	[LibraryImport(DllName)]
+	[SuppressGCTransition]
+	public static partial void ResizeVectorChar8(Vector192* vec, int size);
+
+	[LibraryImport(DllName)]
+	[SuppressGCTransition]
+	public static partial void ResizeVectorChar16(Vector192* vec, int size);
+
+	[LibraryImport(DllName)]
+	[SuppressGCTransition]
+	public static partial void ResizeVectorInt8(Vector192* vec, int size);
+
+	[LibraryImport(DllName)]
+	[SuppressGCTransition]
+	public static partial void ResizeVectorInt16(Vector192* vec, int size);
+
+	[LibraryImport(DllName)]
+	[SuppressGCTransition]
+	public static partial void ResizeVectorInt32(Vector192* vec, int size);
+
+	[LibraryImport(DllName)]
+	[SuppressGCTransition]
+	public static partial void ResizeVectorInt64(Vector192* vec, int size);
+
+	[LibraryImport(DllName)]
+	[SuppressGCTransition]
+	public static partial void ResizeVectorUInt8(Vector192* vec, int size);
+
+	[LibraryImport(DllName)]
+	[SuppressGCTransition]
+	public static partial void ResizeVectorUInt16(Vector192* vec, int size);
+
+	[LibraryImport(DllName)]
+	[SuppressGCTransition]
+	public static partial void ResizeVectorUInt32(Vector192* vec, int size);
+
+	[LibraryImport(DllName)]
+	[SuppressGCTransition]
+	public static partial void ResizeVectorUInt64(Vector192* vec, int size);
+
+	[LibraryImport(DllName)]
+	[SuppressGCTransition]
+	public static partial void ResizeVectorIntPtr(Vector192* vec, int size);
+
+	[LibraryImport(DllName)]
+	[SuppressGCTransition]
+	public static partial void ResizeVectorFloat(Vector192* vec, int size);
+
+	[LibraryImport(DllName)]
+	[SuppressGCTransition]
+	public static partial void ResizeVectorDouble(Vector192* vec, int size);
+
+	[LibraryImport(DllName)]
+	[SuppressGCTransition]
+	public static partial void ResizeVectorVector2(Vector192* vec, int size);
+
+	[LibraryImport(DllName)]
+	[SuppressGCTransition]
+	public static partial void ResizeVectorVector3(Vector192* vec, int size);
+
+	[LibraryImport(DllName)]
+	[SuppressGCTransition]
+	public static partial void ResizeVectorVector4(Vector192* vec, int size);
+
+	[LibraryImport(DllName)]
+	[SuppressGCTransition]
+	public static partial void ResizeVectorMatrix4x4(Vector192* vec, int size);
+
+	#endregion
+
 	#region ConstructVector Functions
 
 	[LibraryImport(DllName)]
@@ -754,7 +1083,17 @@ public static unsafe partial class NativeMethods
 
 	[LibraryImport(DllName)]
 	[SuppressGCTransition]
-	public static partial Vector192 ConstructVectorString([MarshalAs(UnmanagedType.LPArray, ArraySubType = UnmanagedType.LPStr)] [In] string[] arr, int len);
+	public static partial Vector192 ConstructVectorString(byte* data, int* offsets, int len);
+
+	public static Vector192 ConstructVectorString([In] string[] arr, int len)
+	{
+		using var packed = new PackedStrings(arr, len);
+		fixed (byte* data = packed.Data)
+		fixed (int* offsets = packed.Offsets)
+		{
+			return ConstructVectorString(data, offsets, len);
+		}
+	}
 
 	[LibraryImport(DllName)]
 	[SuppressGCTransition]
@@ -929,7 +1268,17 @@ public static unsafe partial class NativeMethods
 
 	[LibraryImport(DllName)]
 	[SuppressGCTransition]
-	public static partial void AssignVectorString(Vector192* vec, [MarshalAs(UnmanagedType.LPArray, ArraySubType = UnmanagedType.LPStr)] [In] string[] arr, int len);
+	public static partial void AssignVectorString(Vector192* vec, byte* data, int* offsets, int len);
+
+	public static void AssignVectorString(Vector192* vec, [In] string[] arr, int len)
+	{
+		using var packed = new PackedStrings(arr, len);
+		fixed (byte* data = packed.Data)
+		fixed (int* offsets = packed.Offsets)
+		{
+			AssignVectorString(vec, data, offsets, len);
+		}
+	}
 
 	[LibraryImport(DllName)]
 	[SuppressGCTransition]
@@ -1006,7 +1355,7 @@ public static unsafe partial class NativeMethods
 	public static Vector192 ConstructVectorDouble([In] double[] arr) 
 	    => ConstructVectorDouble(arr, arr.Length);
 
-	public static Vector192 ConstructVectorString([MarshalAs(UnmanagedType.LPArray, ArraySubType = UnmanagedType.LPStr)] [In] string[] arr) 
+	public static Vector192 ConstructVectorString([In] string[] arr) 
 	    => ConstructVectorString(arr, arr.Length);
 
 	public static Vector192 ConstructVectorVariant([In] object?[] arr) 
@@ -1070,7 +1419,7 @@ public static unsafe partial class NativeMethods
 	public static void AssignVectorDouble(Vector192* vec, [In] double[] arr) 
 	    => AssignVectorDouble(vec, arr, arr.Length);
 
-	public static void AssignVectorString(Vector192* vec, [MarshalAs(UnmanagedType.LPArray, ArraySubType = UnmanagedType.LPStr)] [In] string[] arr) 
+	public static void AssignVectorString(Vector192* vec, [In] string[] arr) 
 	    => AssignVectorString(vec, arr, arr.Length);
 
 	public static void AssignVectorVariant(Vector192* vec, [In] object?[] arr) 
@@ -0,0 +1,39 @@
+using System.Text;
+
+namespace Plugify;
+
+/// <summary>
+/// The caller's plg::string, taken by an export instead of a string. Views its UTF-8 bytes in place, a managed
+/// string is only built when asked for. Only valid for the duration of the call.
+/// </summary>
+public readonly unsafe ref struct NativeStringView
+{
+    private readonly String192* _string;
+
+    internal NativeStringView(nint str)
+    {
+        _string = (String192*)str;
+    }
+
+    /// <summary>
+    /// Length in UTF-8 bytes.
+    /// </summary>
+    public int Length => NativeMethods.GetStringLength(_string);
+
+    public bool IsEmpty => Length == 0;
+
+    public ReadOnlySpan<byte> AsSpan() => NativeMethods.GetStringSpan(_string);
+
+    public bool Equals(ReadOnlySpan<byte> utf8) => AsSpan().SequenceEqual(utf8);
+
+    public bool StartsWith(ReadOnlySpan<byte> utf8) => AsSpan().StartsWith(utf8);
+
+    /// <summary>
+    /// Decodes into <paramref name="destination"/>, returns the number of chars written.
+    /// </summary>
+    public int GetChars(Span<char> destination) => Encoding.UTF8.GetChars(AsSpan(), destination);
+
+    public override string ToString() => NativeMethods.GetStringData(_string);
+
+    public static implicit operator ReadOnlySpan<byte>(NativeStringView view) => view.AsSpan();
+}
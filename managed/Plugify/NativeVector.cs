@@ -0,0 +1,111 @@
+using System.Numerics;
+
+namespace Plugify;
+
+/// <summary>
+/// The caller's plg::vector, taken by an export instead of an array. Reads, writes and resizes go straight to the
+/// native storage, so nothing is copied in or back out. Only valid for the duration of the call.
+/// </summary>
+public readonly unsafe ref struct NativeVector<T> where T : unmanaged
+{
+    private readonly Vector192* _vector;
+
+    internal NativeVector(nint vector)
+    {
+        _vector = (Vector192*)vector;
+    }
+
+    public int Count => Natives.Size(_vector);
+
+    public bool IsEmpty => Count == 0;
+
+    public ref T this[int index]
+    {
+        get
+        {
+            if ((uint)index >= (uint)Count)
+                throw new ArgumentOutOfRangeException(nameof(index));
+
+            return ref ((T*)Natives.Data(_vector))[index];
+        }
+    }
+
+    /// <summary>
+    /// View over the current elements, invalidated by <see cref="Resize"/>, <see cref="Add"/> and <see cref="Clear"/>.
+    /// </summary>
+    public Span<T> AsSpan() => new(Natives.Data(_vector), Count);
+
+    public Span<T>.Enumerator GetEnumerator() => AsSpan().GetEnumerator();
+
+    public void Resize(int count)
+    {
+        ArgumentOutOfRangeException.ThrowIfNegative(count);
+        Natives.Resize(_vector, count);
+    }
+
+    public void Add(T item)
+    {
+        int count = Count;
+        Natives.Resize(_vector, count + 1);
+        ((T*)Natives.Data(_vector))[count] = item;
+    }
+
+    public void Clear() => Natives.Resize(_vector, 0);
+
+    public T[] ToArray() => AsSpan().ToArray();
+
+    // Natives of the element type, picked once per T
+    private static class Natives
+    {
+        public static delegate*<Vector192*, int> Size;
+        public static delegate*<Vector192*, void*> Data;
+        public static delegate*<Vector192*, int, void> Resize;
+
+        static Natives()
+        {
+            if (typeof(T) == typeof(Char8))
+                Bind(&NativeMethods.GetVectorSizeChar8, (delegate*<Vector192*, void*>)&NativeMethods.GetVectorPointerChar8, &NativeMethods.ResizeVectorChar8);
+            else if (typeof(T) == typeof(Char16))
+                Bind(&NativeMethods.GetVectorSizeChar16, (delegate*<Vector192*, void*>)&NativeMethods.GetVectorPointerChar16, &NativeMethods.ResizeVectorChar16);
+            else if (typeof(T) == typeof(sbyte))
+                Bind(&NativeMethods.GetVectorSizeInt8, (delegate*<Vector192*, void*>)&NativeMethods.GetVectorPointerInt8, &NativeMethods.ResizeVectorInt8);
+            else if (typeof(T) == typeof(short))
+                Bind(&NativeMethods.GetVectorSizeInt16, (delegate*<Vector192*, void*>)&NativeMethods.GetVectorPointerInt16, &NativeMethods.ResizeVectorInt16);
+            else if (typeof(T) == typeof(int))
+                Bind(&NativeMethods.GetVectorSizeInt32, (delegate*<Vector192*, void*>)&NativeMethods.GetVectorPointerInt32, &NativeMethods.ResizeVectorInt32);
+            else if (typeof(T) == typeof(long))
+                Bind(&NativeMethods.GetVectorSizeInt64, (delegate*<Vector192*, void*>)&NativeMethods.GetVectorPointerInt64, &NativeMethods.ResizeVectorInt64);
+            else if (typeof(T) == typeof(byte))
+                Bind(&NativeMethods.GetVectorSizeUInt8, (delegate*<Vector192*, void*>)&NativeMethods.GetVectorPointerUInt8, &NativeMethods.ResizeVectorUInt8);
+            else if (typeof(T) == typeof(ushort))
+                Bind(&NativeMethods.GetVectorSizeUInt16, (delegate*<Vector192*, void*>)&NativeMethods.GetVectorPointerUInt16, &NativeMethods.ResizeVectorUInt16);
+            else if (typeof(T) == typeof(uint))
+                Bind(&NativeMethods.GetVectorSizeUInt32, (delegate*<Vector192*, void*>)&NativeMethods.GetVectorPointerUInt32, &NativeMethods.ResizeVectorUInt32);
+            else if (typeof(T) == typeof(ulong))
+                Bind(&NativeMethods.GetVectorSizeUInt64, (delegate*<Vector192*, void*>)&NativeMethods.GetVectorPointerUInt64, &NativeMethods.ResizeVectorUInt64);
+            else if (typeof(T) == typeof(nint))
+                Bind(&NativeMethods.GetVectorSizeIntPtr, (delegate*<Vector192*, void*>)&NativeMethods.GetVectorPointerIntPtr, &NativeMethods.ResizeVectorIntPtr);
+            else if (typeof(T) == typeof(float))
+                Bind(&NativeMethods.GetVectorSizeFloat, (delegate*<Vector192*, void*>)&NativeMethods.GetVectorPointerFloat, &NativeMethods.ResizeVectorFloat);
+            else if (typeof(T) == typeof(double))
+                Bind(&NativeMethods.GetVectorSizeDouble, (delegate*<Vector192*, void*>)&NativeMethods.GetVectorPointerDouble, &NativeMethods.ResizeVectorDouble);
+            else if (typeof(T) == typeof(Vector2))
+                Bind(&NativeMethods.GetVectorSizeVector2, (delegate*<Vector192*, void*>)&NativeMethods.GetVectorPointerVector2, &NativeMethods.ResizeVectorVector2);
+            else if (typeof(T) == typeof(Vector3))
+                Bind(&NativeMethods.GetVectorSizeVector3, (delegate*<Vector192*, void*>)&NativeMethods.GetVectorPointerVector3, &NativeMethods.ResizeVectorVector3);
+            else if (typeof(T) == typeof(Vector4))
+                Bind(&NativeMethods.GetVectorSizeVector4, (delegate*<Vector192*, void*>)&NativeMethods.GetVectorPointerVector4, &NativeMethods.ResizeVectorVector4);
+            else if (typeof(T) == typeof(Matrix4x4))
+                Bind(&NativeMethods.GetVectorSizeMatrix4x4, (delegate*<Vector192*, void*>)&NativeMethods.GetVectorPointerMatrix4x4, &NativeMethods.ResizeVectorMatrix4x4);
+            else
+                throw new NotSupportedException($"NativeVector<{typeof(T).Name}> is not supported, the element type has no native vector.");
+        }
+
+        private static void Bind(delegate*<Vector192*, int> size, delegate*<Vector192*, void*> data, delegate*<Vector192*, int, void> resize)
+        {
+            Size = size;
+            Data = data;
+            Resize = resize;
+        }
+    }
+}
@@ -0,0 +1,10 @@
+namespace Plugify;
+
+/// <summary>
+/// Declares the plugin's OnPluginUpdate safe to run on a worker thread, alongside the updates of other such plugins.
+/// It must only touch the plugin's own state and thread-safe APIs. Unmarked plugins keep updating on the main thread.
+/// </summary>
+[AttributeUsage(AttributeTargets.Class)]
+public class ParallelUpdateAttribute : Attribute
+{
+}
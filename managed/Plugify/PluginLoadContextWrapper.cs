@@ -39,6 +39,8 @@ internal class PluginLoadContextWrapper
         return wrapper;
     }
 
+    internal bool Owns(Assembly assembly) => _pluginLoadContext != null && AssemblyLoadContext.GetLoadContext(assembly) == _pluginLoadContext;
+
     internal void Unload()
     {
         _pluginLoadContext?.Unload();
@@ -0,0 +1,318 @@
+using System.Diagnostics;
+using System.Runtime.InteropServices;
+
+namespace Plugify;
+
+using static ManagedHost;
+
+/// <summary>
+/// Ticks every plugin that implements OnPluginUpdate from a single native call, through delegates
+/// bound once at load instead of a reflection invoke (and a boxed dt) per plugin.
+/// Deferrable plugins are time sliced against <see cref="UpdateScheduler.FrameBudget"/>, parallel ones
+/// run on the thread pool while the frame waits for them. Each pass also pumps the host thread's continuations
+/// and advances <see cref="Timers"/>.
+/// </summary>
+internal static class PluginUpdater
+{
+    private enum UpdateMode
+    {
+        MainThread,
+        Deferred,
+        Parallel
+    }
+
+    private sealed class UpdateEntry(string name, UpdateMode mode, Action<float>? update, Func<float, string?>? updateWithResult)
+    {
+        public readonly string Name = name;
+        public readonly string ZoneName = $"{name}.OnPluginUpdate";
+        public readonly UpdateMode Mode = mode;
+        public readonly Action<float>? Update = update;
+        public readonly Func<float, string?>? UpdateWithResult = updateWithResult;
+        public int Index = -1; // position in the list of its mode, -1 while disabled
+        public float PendingTime; // seconds since a deferred entry last ran
+        public long AverageCost; // Stopwatch ticks, moving average
+        public string? Error; // failure of the last run, held until it is reported on the main thread
+        public Exception? Exception;
+    }
+
+    private static readonly Dictionary<nint, UpdateEntry> Registered = new();
+    private static readonly List<UpdateEntry> Active = new();
+    private static readonly List<UpdateEntry> Deferred = new();
+    private static readonly List<UpdateEntry> Concurrent = new();
+    private static int DeferredCursor;
+
+    private static float ConcurrentTime;
+    private static readonly Action<int> RunConcurrent = i => Execute(Concurrent[i], ConcurrentTime);
+
+    // The shared pool also runs plugins' own continuations and async export completions, so a frame never takes all of it
+    private static readonly ParallelOptions ConcurrentOptions = new() { MaxDegreeOfParallelism = Math.Max(1, Environment.ProcessorCount - 1) };
+
+    private static readonly bool IsProfiling = NativeMethods.IsProfiling();
+
+    internal static void Clear()
+    {
+        Registered.Clear();
+        Active.Clear();
+        Deferred.Clear();
+        Concurrent.Clear();
+        DeferredCursor = 0;
+    }
+
+    internal static TimeSpan GetAverageCost(Plugin plugin)
+    {
+        ArgumentNullException.ThrowIfNull(plugin);
+
+        foreach (var entry in Registered.Values)
+        {
+            if (ReferenceEquals(entry.Update?.Target ?? entry.UpdateWithResult?.Target, plugin))
+            {
+                return TimeSpan.FromTicks(entry.AverageCost * TimeSpan.TicksPerSecond / Stopwatch.Frequency);
+            }
+        }
+
+        return TimeSpan.Zero;
+    }
+
+    // Registered entries stay disabled until the plugin has started
+    [UnmanagedCallersOnly]
+    internal static Bool32 RegisterUpdate(nint objectHandle, nint methodHandle, NativeString name)
+    {
+        try
+        {
+            if (!TypeInterface.CachedMethods.TryGetValue(methodHandle, out var methodInfo))
+            {
+                LogMessage($"Cannot find method {methodHandle}.", MessageLevel.Error);
+                return false;
+            }
+
+            var target = GCHandle.FromIntPtr(objectHandle).Target;
+            if (target == null)
+            {
+                LogMessage($"Invalid target for method {methodInfo.Name}.", MessageLevel.Error);
+                return false;
+            }
+
+            var parameters = methodInfo.GetParameters();
+            if (parameters.Length != 1 || parameters[0].ParameterType != typeof(float))
+            {
+                // Left to the per-plugin path, which reports the mismatch on the first call
+                return false;
+            }
+
+            string? pluginName = name;
+            UpdateMode mode = GetUpdateMode(target.GetType());
+            UpdateEntry entry = methodInfo.ReturnType == typeof(string)
+                ? new UpdateEntry(pluginName ?? string.Empty, mode, null, methodInfo.CreateDelegate<Func<float, string?>>(target))
+                : new UpdateEntry(pluginName ?? string.Empty, mode, methodInfo.CreateDelegate<Action<float>>(target), null);
+
+            UnregisterEntry(objectHandle);
+            Registered.Add(objectHandle, entry);
+            return true;
+        }
+        catch (Exception e)
+        {
+            HandleException(e);
+            return false;
+        }
+    }
+
+    [UnmanagedCallersOnly]
+    internal static void UnregisterUpdate(nint objectHandle)
+    {
+        try
+        {
+            UnregisterEntry(objectHandle);
+        }
+        catch (Exception e)
+        {
+            HandleException(e);
+        }
+    }
+
+    [UnmanagedCallersOnly]
+    internal static void SetUpdateEnabled(nint objectHandle, Bool32 enabled)
+    {
+        try
+        {
+            if (!Registered.TryGetValue(objectHandle, out var entry))
+                return;
+
+            if (enabled)
+            {
+                if (entry.Index < 0)
+                {
+                    var list = GetList(entry);
+                    entry.Index = list.Count;
+                    entry.PendingTime = 0;
+                    list.Add(entry);
+                }
+            }
+            else
+            {
+                Deactivate(entry);
+            }
+        }
+        catch (Exception e)
+        {
+            HandleException(e);
+        }
+    }
+
+    [UnmanagedCallersOnly]
+    internal static void UpdatePlugins(float dt)
+    {
+        long frameStart = Stopwatch.GetTimestamp();
+
+        // Awaits of the previous frames resume first, on this thread
+        MainThreadSynchronizationContext.Instance.Pump((long)(UpdateScheduler.ContinuationBudget.TotalSeconds * Stopwatch.Frequency));
+        Timers.Advance(dt);
+
+        // Indexed loops, an update may disable a plugin (swapping the last entry in) without breaking the pass
+        for (int i = 0; i < Active.Count; i++)
+        {
+            Run(Active[i], dt);
+        }
+
+        // Work-stealing over the thread pool with the main thread joining in, returns once every update is done
+        if (Concurrent.Count > 1)
+        {
+            ConcurrentTime = dt;
+            Parallel.For(0, Concurrent.Count, ConcurrentOptions, RunConcurrent);
+
+            // The plugin vouches for its own state only, the host's logger and profiler are still main thread only
+            for (int i = 0; i < Concurrent.Count; i++)
+            {
+                Report(Concurrent[i]);
+            }
+        }
+        else if (Concurrent.Count == 1)
+        {
+            Run(Concurrent[0], dt);
+        }
+
+        if (Deferred.Count == 0)
+            return;
+
+        foreach (var entry in Deferred)
+        {
+            entry.PendingTime += dt;
+        }
+
+        long budget = (long)(UpdateScheduler.FrameBudget.TotalSeconds * Stopwatch.Frequency);
+
+        // Round robin from where the previous frame stopped, at least one deferred plugin runs per frame
+        int count = Deferred.Count;
+        int ran = 0;
+        while (ran < count && Deferred.Count > 0)
+        {
+            var entry = Deferred[(DeferredCursor + ran) % Deferred.Count];
+            if (budget > 0 && ran > 0 && Stopwatch.GetTimestamp() - frameStart + entry.AverageCost > budget)
+                break;
+
+            float elapsed = entry.PendingTime;
+            entry.PendingTime = 0;
+            Run(entry, elapsed);
+            ran++;
+        }
+
+        DeferredCursor = Deferred.Count > 0 ? (DeferredCursor + ran) % Deferred.Count : 0;
+    }
+
+    private static void Run(UpdateEntry entry, float dt)
+    {
+        ulong zone = IsProfiling ? NativeMethods.BeginZone(entry.ZoneName, 0, string.Empty, "OnPluginUpdate", entry.Name) : 0;
+
+        Execute(entry, dt);
+
+        if (zone != 0)
+            NativeMethods.EndZone(zone);
+
+        Report(entry);
+    }
+
+    // Calls into no host service, so it may run on a thread pool thread. Parallel entries get no profiler zone.
+    private static void Execute(UpdateEntry entry, float dt)
+    {
+        long start = Stopwatch.GetTimestamp();
+
+        try
+        {
+            if (entry.Update != null)
+            {
+                entry.Update(dt);
+            }
+            else
+            {
+                entry.Error = entry.UpdateWithResult!(dt);
+            }
+        }
+        catch (Exception e)
+        {
+            entry.Exception = e;
+        }
+
+        long cost = Stopwatch.GetTimestamp() - start;
+        entry.AverageCost = entry.AverageCost == 0 ? cost : entry.AverageCost + (cost - entry.AverageCost) / 8;
+    }
+
+    private static void Report(UpdateEntry entry)
+    {
+        if (entry.Error is { Length: > 0 } error)
+        {
+            LogMessage($"{entry.Name}: call of 'OnPluginUpdate' failed\n{error}", MessageLevel.Error);
+        }
+
+        if (entry.Exception is { } exception)
+        {
+            HandleException(exception);
+        }
+
+        entry.Error = null;
+        entry.Exception = null;
+    }
+
+    private static UpdateMode GetUpdateMode(Type pluginType)
+    {
+        if (pluginType.IsDefined(typeof(ParallelUpdateAttribute), inherit: true))
+            return UpdateMode.Parallel;
+
+        if (pluginType.IsDefined(typeof(DeferrableUpdateAttribute), inherit: true))
+            return UpdateMode.Deferred;
+
+        return UpdateMode.MainThread;
+    }
+
+    private static List<UpdateEntry> GetList(UpdateEntry entry) => entry.Mode switch
+    {
+        UpdateMode.Deferred => Deferred,
+        UpdateMode.Parallel => Concurrent,
+        _ => Active
+    };
+
+    private static void UnregisterEntry(nint objectHandle)
+    {
+        if (Registered.Remove(objectHandle, out var entry))
+        {
+            Deactivate(entry);
+        }
+    }
+
+    // Swap-remove keeps the lists dense
+    private static void Deactivate(UpdateEntry entry)
+    {
+        int index = entry.Index;
+        if (index < 0)
+            return;
+
+        var list = GetList(entry);
+        int last = list.Count - 1;
+        if (index != last)
+        {
+            list[index] = list[last];
+            list[index].Index = index;
+        }
+
+        list.RemoveAt(last);
+        entry.Index = -1;
+    }
+}
@@ -0,0 +1,309 @@
+using System.Reflection;
+
+namespace Plugify;
+
+using static ManagedHost;
+
+/// <summary>
+/// Identifies a timer created by <see cref="Timers"/>. The default value refers to no timer.
+/// </summary>
+public readonly struct TimerHandle : IEquatable<TimerHandle>
+{
+    internal readonly int Index;
+    internal readonly int Generation;
+
+    internal TimerHandle(int index, int generation)
+    {
+        Index = index;
+        Generation = generation;
+    }
+
+    public bool Equals(TimerHandle other) => Index == other.Index && Generation == other.Generation;
+    public override bool Equals(object? obj) => obj is TimerHandle other && Equals(other);
+    public override int GetHashCode() => HashCode.Combine(Index, Generation);
+
+    public static bool operator ==(TimerHandle left, TimerHandle right) => left.Equals(right);
+    public static bool operator !=(TimerHandle left, TimerHandle right) => !left.Equals(right);
+}
+
+/// <summary>
+/// Delayed and repeating callbacks, run on the host thread by the module's update with a millisecond resolution.
+/// Backed by a hierarchical timer wheel: scheduling and cancelling are O(1), each frame advances the wheel once
+/// and fires the expired timers together. Not thread-safe, call it from the host thread only.
+/// </summary>
+public static class Timers
+{
+    private struct TimerNode
+    {
+        public Action? Callback;
+        public long Expires; // tick
+        public long Interval; // ticks, 0 for one-shot timers
+        public int Next; // in the slot list, or the free list
+        public int Prev;
+        public int Slot; // -1 while not queued
+        public int Generation;
+    }
+
+    // 4 levels of 256 slots, the last one reaches 2^32 ms (~49 days) ahead
+    private const int SlotBits = 8;
+    private const int SlotCount = 1 << SlotBits;
+    private const int SlotMask = SlotCount - 1;
+    private const int LevelCount = 4;
+    private const long MaxDelay = (1L << (SlotBits * LevelCount)) - 1;
+
+    private const double TicksPerSecond = 1000.0;
+
+    private static readonly int[] Heads = CreateHeads();
+    private static TimerNode[] Nodes = new TimerNode[64];
+    private static int NodeCount;
+    private static int FreeList = -1;
+    private static int Scheduled;
+
+    private static long Now; // last tick processed
+    private static double Remainder; // seconds not yet turned into a tick
+
+    /// <summary>
+    /// Runs <paramref name="callback"/> once, <paramref name="delay"/> from now.
+    /// </summary>
+    public static TimerHandle Schedule(TimeSpan delay, Action callback)
+    {
+        ArgumentNullException.ThrowIfNull(callback);
+        return Add(ToTicks(delay), 0, callback);
+    }
+
+    /// <summary>
+    /// Runs <paramref name="callback"/> every <paramref name="interval"/>, until cancelled.
+    /// </summary>
+    public static TimerHandle Every(TimeSpan interval, Action callback)
+    {
+        ArgumentNullException.ThrowIfNull(callback);
+        long ticks = ToTicks(interval);
+        return Add(ticks, ticks, callback);
+    }
+
+    /// <summary>
+    /// Stops the timer. Returns false when it already fired (one-shot) or was cancelled.
+    /// </summary>
+    public static bool Cancel(TimerHandle handle)
+    {
+        if (!IsScheduled(handle))
+            return false;
+
+        Unlink(handle.Index);
+        Release(handle.Index);
+        return true;
+    }
+
+    public static bool IsScheduled(TimerHandle handle)
+    {
+        return handle.Generation != 0 && (uint)handle.Index < (uint)NodeCount
+            && Nodes[handle.Index].Generation == handle.Generation && Nodes[handle.Index].Slot >= 0;
+    }
+
+    internal static void Advance(float dt)
+    {
+        Remainder += dt;
+        long ticks = (long)(Remainder * TicksPerSecond);
+        if (ticks <= 0)
+            return;
+
+        Remainder -= ticks / TicksPerSecond;
+        long target = Now + ticks;
+
+        while (Now < target)
+        {
+            if (Scheduled == 0)
+            {
+                Now = target;
+                break;
+            }
+
+            Now++;
+
+            int index = (int)(Now & SlotMask);
+            if (index == 0)
+            {
+                Cascade();
+            }
+
+            Fire(index);
+        }
+    }
+
+    // Timers of plugins being unloaded would keep their load context alive
+    internal static void RemoveOwnedBy(Assembly assembly)
+    {
+        for (int i = 0; i < NodeCount; i++)
+        {
+            ref var node = ref Nodes[i];
+            if (node.Slot >= 0 && (node.Callback!.Method.Module.Assembly == assembly || node.Callback.Target?.GetType().Assembly == assembly))
+            {
+                Unlink(i);
+                Release(i);
+            }
+        }
+    }
+
+    internal static void Clear()
+    {
+        Array.Fill(Heads, -1);
+        Array.Clear(Nodes);
+        NodeCount = 0;
+        FreeList = -1;
+        Scheduled = 0;
+        Now = 0;
+        Remainder = 0;
+    }
+
+    private static int[] CreateHeads()
+    {
+        var heads = new int[LevelCount * SlotCount];
+        Array.Fill(heads, -1);
+        return heads;
+    }
+
+    private static long ToTicks(TimeSpan time)
+    {
+        // Never due on the tick being processed, a zero interval would otherwise spin forever
+        return Math.Clamp((time.Ticks + TimeSpan.TicksPerMillisecond - 1) / TimeSpan.TicksPerMillisecond, 1, MaxDelay);
+    }
+
+    private static TimerHandle Add(long delay, long interval, Action callback)
+    {
+        int index = Allocate();
+        ref var node = ref Nodes[index];
+        node.Callback = callback;
+        node.Expires = Now + delay;
+        node.Interval = interval;
+        Insert(index);
+        return new TimerHandle(index, node.Generation);
+    }
+
+    private static int Allocate()
+    {
+        int index;
+        if (FreeList >= 0)
+        {
+            index = FreeList;
+            FreeList = Nodes[index].Next;
+        }
+        else
+        {
+            if (NodeCount == Nodes.Length)
+            {
+                Array.Resize(ref Nodes, Nodes.Length * 2);
+            }
+
+            index = NodeCount++;
+        }
+
+        ref var node = ref Nodes[index];
+        node.Generation = node.Generation == int.MaxValue ? 1 : node.Generation + 1;
+        node.Slot = -1;
+        return index;
+    }
+
+    private static void Release(int index)
+    {
+        ref var node = ref Nodes[index];
+        node.Callback = null;
+        node.Generation = node.Generation == int.MaxValue ? 1 : node.Generation + 1;
+        node.Next = FreeList;
+        FreeList = index;
+    }
+
+    // The level is picked by how far ahead the timer expires, the slot by the matching bits of its expiry
+    private static void Insert(int index)
+    {
+        ref var node = ref Nodes[index];
+        long delta = node.Expires - Now;
+
+        int level = 0;
+        while (level < LevelCount - 1 && delta >= 1L << (SlotBits * (level + 1)))
+        {
+            level++;
+        }
+
+        int slot = level * SlotCount + (int)((node.Expires >> (SlotBits * level)) & SlotMask);
+
+        node.Slot = slot;
+        node.Prev = -1;
+        node.Next = Heads[slot];
+        if (node.Next >= 0)
+        {
+            Nodes[node.Next].Prev = index;
+        }
+        Heads[slot] = index;
+        Scheduled++;
+    }
+
+    private static void Unlink(int index)
+    {
+        ref var node = ref Nodes[index];
+        if (node.Prev >= 0)
+            Nodes[node.Prev].Next = node.Next;
+        else
+            Heads[node.Slot] = node.Next;
+
+        if (node.Next >= 0)
+            Nodes[node.Next].Prev = node.Prev;
+
+        node.Slot = -1;
+        Scheduled--;
+    }
+
+    // Once the lower levels wrapped, the due slot of each higher level is spread over the levels below it,
+    // highest first so everything moved down reaches level 0 within the same tick
+    private static void Cascade()
+    {
+        int level = 1;
+        while (level < LevelCount - 1 && ((Now >> (SlotBits * level)) & SlotMask) == 0)
+        {
+            level++;
+        }
+
+        for (; level > 0; level--)
+        {
+            int slot = level * SlotCount + (int)((Now >> (SlotBits * level)) & SlotMask);
+            int index = Heads[slot];
+            while (index >= 0)
+            {
+                int next = Nodes[index].Next;
+                Unlink(index);
+                Insert(index);
+                index = next;
+            }
+        }
+    }
+
+    private static void Fire(int slot)
+    {
+        // Callbacks may schedule or cancel, the slot is drained from its head until empty
+        while (Heads[slot] >= 0)
+        {
+            int index = Heads[slot];
+            Unlink(index);
+
+            ref var node = ref Nodes[index];
+            var callback = node.Callback!;
+            if (node.Interval > 0)
+            {
+                node.Expires += node.Interval;
+                Insert(index);
+            }
+            else
+            {
+                Release(index);
+            }
+
+            try
+            {
+                callback();
+            }
+            catch (Exception e)
+            {
+                HandleException(e);
+            }
+        }
+    }
+}
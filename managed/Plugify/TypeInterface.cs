@@ -2,6 +2,7 @@ using System.Collections.Immutable;
 using System.Linq.Expressions;
 using System.Reflection;
 using System.Runtime.InteropServices;
+using System.Text;
 
 namespace Plugify;
 
@@ -76,7 +77,7 @@ internal static class TypeInterface
     }*/
     
     [UnmanagedCallersOnly]
-    private static unsafe void GetAssemblyTypes(Guid assemblyId, nint* outTypeArrayPtr, int* outTypeCount)
+    internal static unsafe void GetAssemblyTypes(Guid assemblyId, nint* outTypeArrayPtr, int* outTypeCount)
     {
         try
         {
@@ -117,7 +118,45 @@ internal static class TypeInterface
 	}
 
 	[UnmanagedCallersOnly]
-	private static unsafe void GetType(NativeString name, nint* outType)
+	internal static unsafe void GetAssemblyTypeNames(Guid assemblyId, nint* outTypeArrayPtr, NativeString* outNameArrayPtr, NativeString* outBaseNameArrayPtr, int* outTypeCount)
+	{
+		try
+		{
+			if (!AssemblyLoader.TryGetAssembly(assemblyId, out var wrapper))
+			{
+				LogMessage($"Couldn't get types for assembly '{assemblyId}', assembly not found.", MessageLevel.Error);
+				return;
+			}
+
+			if (!wrapper.IsAlive || !wrapper.Assembly.TryGetTarget(out var assembly))
+			{
+				LogMessage($"Couldn't get types for assembly '{assemblyId}', assembly was unloaded.", MessageLevel.Error);
+				return;
+			}
+
+			Type[] assemblyTypes = assembly.GetTypes();
+
+			*outTypeCount = assemblyTypes.Length;
+
+			if (outTypeArrayPtr == null || outNameArrayPtr == null || outBaseNameArrayPtr == null)
+				return;
+
+			for (int i = 0; i < assemblyTypes.Length; i++)
+			{
+				Type type = assemblyTypes[i];
+				outTypeArrayPtr[i] = CachedTypes.Add(type);
+				outNameArrayPtr[i] = type.FullName;
+				outBaseNameArrayPtr[i] = type.BaseType?.FullName;
+			}
+		}
+		catch (Exception e)
+		{
+			HandleException(e);
+		}
+	}
+
+	[UnmanagedCallersOnly]
+	internal static unsafe void GetType(NativeString name, nint* outType)
 	{
 		try
 		{
@@ -138,7 +177,7 @@ internal static class TypeInterface
 	}
 
 	[UnmanagedCallersOnly]
-	private static unsafe NativeString GetFullTypeName(nint typeHandle)
+	internal static unsafe NativeString GetFullTypeName(nint typeHandle)
 	{
 		try
 		{
@@ -155,7 +194,7 @@ internal static class TypeInterface
 	}
 
 	[UnmanagedCallersOnly]
-	private static unsafe NativeString GetAssemblyQualifiedName(nint typeHandle)
+	internal static unsafe NativeString GetAssemblyQualifiedName(nint typeHandle)
 	{
 		try
 		{
@@ -171,8 +210,48 @@ internal static class TypeInterface
 		}
 	}
 
+	// Arrays and generic instantiations over plugin types are unloaded together with that plugin
+	private static Assembly GetOwningAssembly(Type type)
+	{
+		if (type.HasElementType)
+			return GetOwningAssembly(type.GetElementType()!);
+
+		foreach (var argument in type.GenericTypeArguments)
+		{
+			if (argument.IsCollectible)
+				return GetOwningAssembly(argument);
+		}
+
+		return type.Assembly;
+	}
+
+	// Returns the id of the plugin assembly whose load context owns the type, empty for shared types
 	[UnmanagedCallersOnly]
-	private static unsafe void GetBaseType(nint typeHandle, nint* outBaseType)
+	internal static Guid GetTypeAssemblyId(nint typeHandle)
+	{
+		try
+		{
+			if (!CachedTypes.TryGetValue(typeHandle, out var type) || !type.IsCollectible)
+				return Guid.Empty;
+
+			var assembly = GetOwningAssembly(type);
+			foreach (var (id, wrapper) in AssemblyLoader.LoadedAssemblies)
+			{
+				if (wrapper.Owns(assembly))
+					return id;
+			}
+
+			return Guid.Empty;
+		}
+		catch (Exception e)
+		{
+			HandleException(e);
+			return Guid.Empty;
+		}
+	}
+
+	[UnmanagedCallersOnly]
+	internal static unsafe void GetBaseType(nint typeHandle, nint* outBaseType)
 	{
 		try
 		{
@@ -194,7 +273,7 @@ internal static class TypeInterface
 	}
 
 	[UnmanagedCallersOnly]
-	private static int GetTypeSize(nint typeHandle)
+	internal static int GetTypeSize(nint typeHandle)
 	{
 		try
 		{
@@ -211,7 +290,7 @@ internal static class TypeInterface
 	}
 
 	[UnmanagedCallersOnly]
-	private static unsafe Bool32 IsTypeSubclassOf(nint typeHandle0, nint typeHandle1)
+	internal static unsafe Bool32 IsTypeSubclassOf(nint typeHandle0, nint typeHandle1)
 	{
 		try
 		{
@@ -228,7 +307,7 @@ internal static class TypeInterface
 	}
 
 	[UnmanagedCallersOnly]
-	private static unsafe Bool32 IsTypeAssignableTo(nint typeHandle0, nint typeHandle1)
+	internal static unsafe Bool32 IsTypeAssignableTo(nint typeHandle0, nint typeHandle1)
 	{
 		try
 		{
@@ -245,7 +324,7 @@ internal static class TypeInterface
 	}
 
 	[UnmanagedCallersOnly]
-	private static unsafe Bool32 IsTypeAssignableFrom(nint typeHandle0, nint typeHandle1)
+	internal static unsafe Bool32 IsTypeAssignableFrom(nint typeHandle0, nint typeHandle1)
 	{
 		try
 		{
@@ -262,7 +341,7 @@ internal static class TypeInterface
 	}
 
 	[UnmanagedCallersOnly]
-	private static unsafe Bool32 IsTypeSZArray(nint typeHandle)
+	internal static unsafe Bool32 IsTypeSZArray(nint typeHandle)
 	{
 		try
 		{
@@ -279,7 +358,7 @@ internal static class TypeInterface
 	}
 
 	[UnmanagedCallersOnly]
-	private static unsafe Bool32 IsTypeByRef(nint typeHandle)
+	internal static unsafe Bool32 IsTypeByRef(nint typeHandle)
 	{
 		try
 		{
@@ -296,7 +375,7 @@ internal static class TypeInterface
 	}
 
 	[UnmanagedCallersOnly]
-	private static unsafe void GetElementType(nint typeHandle, nint* outElementTypeId)
+	internal static unsafe void GetElementType(nint typeHandle, nint* outElementTypeId)
 	{
 		try
 		{
@@ -317,7 +396,7 @@ internal static class TypeInterface
 	}
 
 	[UnmanagedCallersOnly]
-	private static unsafe void GetTypeMethods(nint typeHandle, nint* outMethodArrayPtr, int* outMethodCount)
+	internal static unsafe void GetTypeMethods(nint typeHandle, nint* outMethodArrayPtr, int* outMethodCount)
 	{
 		try
 		{
@@ -349,7 +428,7 @@ internal static class TypeInterface
 	}
 
 	[UnmanagedCallersOnly]
-	private static unsafe void GetTypeFields(nint typeHandle, nint* outFieldArrayPtr, int* outFieldCount)
+	internal static unsafe void GetTypeFields(nint typeHandle, nint* outFieldArrayPtr, int* outFieldCount)
 	{
 		try
 		{
@@ -381,7 +460,7 @@ internal static class TypeInterface
 	}
 
 	[UnmanagedCallersOnly]
-	private static unsafe void GetTypeProperties(nint typeHandle, nint* outPropertyArrayPtr, int* outPropertyCount)
+	internal static unsafe void GetTypeProperties(nint typeHandle, nint* outPropertyArrayPtr, int* outPropertyCount)
 	{
 		try
 		{
@@ -413,7 +492,7 @@ internal static class TypeInterface
 	}
 	
 	[UnmanagedCallersOnly]
-	private static unsafe void GetTypeMethod(nint typeHandle, NativeString name, nint* outMethod)
+	internal static unsafe void GetTypeMethod(nint typeHandle, NativeString name, nint* outMethod)
 	{
 		try
 		{
@@ -437,7 +516,7 @@ internal static class TypeInterface
 	}
 
 	[UnmanagedCallersOnly]
-	private static unsafe void GetTypeField(nint typeHandle, NativeString name, nint* outField)
+	internal static unsafe void GetTypeField(nint typeHandle, NativeString name, nint* outField)
 	{
 		try
 		{
@@ -461,7 +540,7 @@ internal static class TypeInterface
 	}
 
 	[UnmanagedCallersOnly]
-	private static unsafe void GetTypeProperty(nint typeHandle, NativeString name, nint* outProperty)
+	internal static unsafe void GetTypeProperty(nint typeHandle, NativeString name, nint* outProperty)
 	{
 		try
 		{
@@ -485,7 +564,7 @@ internal static class TypeInterface
 	}
 
 	[UnmanagedCallersOnly]
-	private static unsafe Bool32 HasTypeAttribute(nint typeHandle, nint attributeTypeHandle)
+	internal static unsafe Bool32 HasTypeAttribute(nint typeHandle, nint attributeTypeHandle)
 	{
 		try
 		{
@@ -502,7 +581,7 @@ internal static class TypeInterface
 	}
 
 	[UnmanagedCallersOnly]
-	private static unsafe void GetTypeAttributes(nint typeHandle, nint* outAttributeArrayPtr, int* outAttributeCount)
+	internal static unsafe void GetTypeAttributes(nint typeHandle, nint* outAttributeArrayPtr, int* outAttributeCount)
 	{
 		try
 		{
@@ -535,7 +614,7 @@ internal static class TypeInterface
 	}
 
 	[UnmanagedCallersOnly]
-	private static unsafe ManagedType GetTypeManagedType(nint typeHandle)
+	internal static unsafe ManagedType GetTypeManagedType(nint typeHandle)
 	{
 		try
 		{
@@ -552,7 +631,7 @@ internal static class TypeInterface
 	}
 
 	[UnmanagedCallersOnly]
-	private static unsafe NativeString GetMethodInfoName(nint methodHandle)
+	internal static unsafe NativeString GetMethodInfoName(nint methodHandle)
 	{
 		try
 		{
@@ -569,7 +648,7 @@ internal static class TypeInterface
 	}
 
 	[UnmanagedCallersOnly]
-	private static unsafe nint GetMethodInfoFunctionAddress(nint methodHandle)
+	internal static unsafe nint GetMethodInfoFunctionAddress(nint methodHandle)
 	{
 		try
 		{
@@ -586,7 +665,7 @@ internal static class TypeInterface
 	}
 
 	[UnmanagedCallersOnly]
-	private static unsafe void GetMethodInfoReturnType(nint methodHandle, nint* outReturnType)
+	internal static unsafe void GetMethodInfoReturnType(nint methodHandle, nint* outReturnType)
 	{
 		try
 		{
@@ -602,7 +681,7 @@ internal static class TypeInterface
 	}
 
 	[UnmanagedCallersOnly]
-	private static unsafe void GetMethodInfoParameterTypes(nint methodHandle, nint* outParameterTypeArrayPtr, int* outParameterCount)
+	internal static unsafe void GetMethodInfoParameterTypes(nint methodHandle, nint* outParameterTypeArrayPtr, int* outParameterCount)
 	{
 		try
 		{
@@ -633,7 +712,7 @@ internal static class TypeInterface
 	}
 
 	[UnmanagedCallersOnly]
-	private static unsafe void GetMethodInfoAttributes(nint methodHandle, nint* outAttributeArrayPtr, int* outAttributeCount)
+	internal static unsafe void GetMethodInfoAttributes(nint methodHandle, nint* outAttributeArrayPtr, int* outAttributeCount)
 	{
 		try
 		{
@@ -665,7 +744,7 @@ internal static class TypeInterface
 	}
 
 	[UnmanagedCallersOnly]
-	private static unsafe void GetMethodInfoParameterAttributes(nint methodHandle, int parameterIndex, nint* outAttributeArrayPtr, int* outAttributeCount)
+	internal static unsafe void GetMethodInfoParameterAttributes(nint methodHandle, int parameterIndex, nint* outAttributeArrayPtr, int* outAttributeCount)
 	{
 		try
 		{
@@ -704,7 +783,7 @@ internal static class TypeInterface
 	}
 
 	[UnmanagedCallersOnly]
-	private static unsafe void GetMethodInfoReturnAttributes(nint methodHandle, nint* outAttributeArrayPtr, int* outAttributeCount)
+	internal static unsafe void GetMethodInfoReturnAttributes(nint methodHandle, nint* outAttributeArrayPtr, int* outAttributeCount)
 	{
 		try
 		{
@@ -735,7 +814,7 @@ internal static class TypeInterface
 		}
 	}
 
-	private enum TypeAccessibility
+	internal enum TypeAccessibility
 	{
 		Public,
 		Private,
@@ -768,7 +847,7 @@ internal static class TypeInterface
 	}
 
 	[UnmanagedCallersOnly]
-	private static unsafe TypeAccessibility GetMethodInfoAccessibility(nint methodHandle)
+	internal static unsafe TypeAccessibility GetMethodInfoAccessibility(nint methodHandle)
 	{
 		try
 		{
@@ -785,7 +864,7 @@ internal static class TypeInterface
 	}
 
 	[UnmanagedCallersOnly]
-	private static unsafe NativeString GetFieldInfoName(nint fieldHandle)
+	internal static unsafe NativeString GetFieldInfoName(nint fieldHandle)
 	{
 		try
 		{
@@ -802,7 +881,7 @@ internal static class TypeInterface
 	}
 
 	[UnmanagedCallersOnly]
-	private static unsafe void GetFieldInfoType(nint fieldHandle, nint* outFieldType)
+	internal static unsafe void GetFieldInfoType(nint fieldHandle, nint* outFieldType)
 	{
 		try
 		{
@@ -818,7 +897,7 @@ internal static class TypeInterface
 	}
 
 	[UnmanagedCallersOnly]
-	private static unsafe TypeAccessibility GetFieldInfoAccessibility(nint fieldHandle)
+	internal static unsafe TypeAccessibility GetFieldInfoAccessibility(nint fieldHandle)
 	{
 		try
 		{
@@ -835,7 +914,7 @@ internal static class TypeInterface
 	}
 
 	[UnmanagedCallersOnly]
-	private static unsafe void GetFieldInfoAttributes(nint fieldHandle, nint* outAttributeArrayPtr, int* outAttributeCount)
+	internal static unsafe void GetFieldInfoAttributes(nint fieldHandle, nint* outAttributeArrayPtr, int* outAttributeCount)
 	{
 		try
 		{
@@ -867,7 +946,7 @@ internal static class TypeInterface
 	}
 
 	[UnmanagedCallersOnly]
-	private static unsafe NativeString GetPropertyInfoName(nint propertyHandle)
+	internal static unsafe NativeString GetPropertyInfoName(nint propertyHandle)
 	{
 		try
 		{
@@ -884,7 +963,7 @@ internal static class TypeInterface
 	}
 
 	[UnmanagedCallersOnly]
-	private static unsafe void GetPropertyInfoType(nint propertyHandle, nint* outPropertyType)
+	internal static unsafe void GetPropertyInfoType(nint propertyHandle, nint* outPropertyType)
 	{
 		try
 		{
@@ -900,7 +979,7 @@ internal static class TypeInterface
 	}
 
 	[UnmanagedCallersOnly]
-	private static unsafe void GetPropertyInfoAttributes(nint propertyHandle, nint* outAttributeArrayPtr, int* outAttributeCount)
+	internal static unsafe void GetPropertyInfoAttributes(nint propertyHandle, nint* outAttributeArrayPtr, int* outAttributeCount)
 	{
 		try
 		{
@@ -932,7 +1011,7 @@ internal static class TypeInterface
 	}
 
 	[UnmanagedCallersOnly]
-	private static unsafe void GetAttributeFieldValue(nint attributeHandle, NativeString fieldName, nint outValue)
+	internal static unsafe void GetAttributeFieldValue(nint attributeHandle, NativeString fieldName, nint outValue)
 	{
 		try
 		{
@@ -957,7 +1036,7 @@ internal static class TypeInterface
 	}
 
 	[UnmanagedCallersOnly]
-	private static unsafe void GetAttributeType(nint attributeHandle, nint* outType)
+	internal static unsafe void GetAttributeType(nint attributeHandle, nint* outType)
 	{
 		try
 		{
@@ -973,7 +1052,7 @@ internal static class TypeInterface
 	}
 
 	[UnmanagedCallersOnly]
-	private static unsafe Bool32 IsClass(nint typeHandle)
+	internal static unsafe Bool32 IsClass(nint typeHandle)
 	{
 		try
 		{
@@ -989,7 +1068,7 @@ internal static class TypeInterface
 	}
 
 	[UnmanagedCallersOnly]
-	private static unsafe Bool32 IsEnum(nint typeHandle)
+	internal static unsafe Bool32 IsEnum(nint typeHandle)
 	{
 		try
 		{
@@ -1005,7 +1084,7 @@ internal static class TypeInterface
 	}
 
 	[UnmanagedCallersOnly]
-	private static unsafe Bool32 IsValueType(nint typeHandle)
+	internal static unsafe Bool32 IsValueType(nint typeHandle)
 	{
 		try
 		{
@@ -1021,7 +1100,7 @@ internal static class TypeInterface
 	}
 	
 	[UnmanagedCallersOnly]
-	private static unsafe void GetEnumNames(nint typeHandle, NativeString* outNameArrayPtr, int* outCount)
+	internal static unsafe void GetEnumNames(nint typeHandle, NativeString* outNameArrayPtr, int* outCount)
 	{
 		try
 		{
@@ -1045,7 +1124,7 @@ internal static class TypeInterface
 	}
 		
 	[UnmanagedCallersOnly]
-	private static unsafe void GetEnumValues(nint typeHandle, long* outValueArrayPtr, int* outCount)
+	internal static unsafe void GetEnumValues(nint typeHandle, long* outValueArrayPtr, int* outCount)
 	{
 		try
 		{
@@ -1067,4 +1146,205 @@ internal static class TypeInterface
 			HandleException(e);
 		}
 	}
+
+	#region Metadata snapshot
+
+	// Layout shared with src/metadata_snapshot.hpp, bump both versions together
+	private const uint MetadataMagic = 0x4D474C50; // "PLGM"
+	private const uint MetadataVersion = 2;
+
+	private struct MetadataString
+	{
+		public int Offset;
+		public int Length;
+	}
+
+	private struct MetadataHeader
+	{
+		public uint Magic;
+		public uint Version;
+		public int TypeCount;
+		public int TypesOffset;
+		public int MethodCount;
+		public int MethodsOffset;
+		public int ParameterCount;
+		public int ParametersOffset;
+		public int AttributeCount;
+		public int AttributesOffset;
+		public int StringsSize;
+		public int StringsOffset;
+	}
+
+	private struct TypeMetadata
+	{
+		public nint Handle;
+		public MetadataString Name;
+		public MetadataString BaseName;
+		public int FirstMethod;
+		public int MethodCount;
+		public int FirstAttribute;
+		public int AttributeCount;
+	}
+
+	private struct MethodMetadata
+	{
+		public nint Handle;
+		public MetadataString Name;
+		public ManagedType ReturnType;
+		public byte Accessibility;
+		public Bool8 IsStatic;
+		public Bool8 IsAsync; // returns a task, ReturnType is the awaited result
+		public int FirstParameter;
+		public int ParameterCount;
+		public int FirstAttribute;
+		public int AttributeCount;
+	}
+
+	private struct AttributeMetadata
+	{
+		public MetadataString TypeName;
+	}
+
+	private sealed class MetadataStrings
+	{
+		private readonly Dictionary<string, MetadataString> _offsets = new();
+		private readonly List<byte> _bytes = new();
+
+		public MetadataString Add(string? value)
+		{
+			if (string.IsNullOrEmpty(value))
+				return default;
+
+			if (!_offsets.TryGetValue(value, out var str))
+			{
+				byte[] utf8 = Encoding.UTF8.GetBytes(value);
+				str = new MetadataString { Offset = _bytes.Count, Length = utf8.Length };
+				_bytes.AddRange(utf8);
+				_offsets.Add(value, str);
+			}
+
+			return str;
+		}
+
+		public ReadOnlySpan<byte> Bytes => CollectionsMarshal.AsSpan(_bytes);
+	}
+
+	private static void AddAttributes(IList<CustomAttributeData> attributes, List<AttributeMetadata> output, MetadataStrings strings)
+	{
+		foreach (var attribute in attributes)
+		{
+			output.Add(new AttributeMetadata { TypeName = strings.Add(attribute.AttributeType.FullName) });
+		}
+	}
+
+	private static unsafe void WriteSection<T>(byte* buffer, int offset, List<T> items) where T : unmanaged
+	{
+		CollectionsMarshal.AsSpan(items).CopyTo(new Span<T>(buffer + offset, items.Count));
+	}
+
+	private static int AlignSection(int offset) => (offset + 7) & ~7;
+
+	// Returns a CoTaskMem buffer owned by the caller, describing every type of the assembly with its
+	// methods (the inherited ones Type.GetMethod would find included), parameter types and attribute names
+	[UnmanagedCallersOnly]
+	internal static unsafe byte* GetAssemblyMetadata(Guid assemblyId, int* outSize)
+	{
+		try
+		{
+			*outSize = 0;
+
+			if (!AssemblyLoader.TryGetAssembly(assemblyId, out var wrapper) || !wrapper.IsAlive || !wrapper.Assembly.TryGetTarget(out var assembly))
+			{
+				LogMessage($"Couldn't get metadata for assembly '{assemblyId}', assembly not found.", MessageLevel.Error);
+				return null;
+			}
+
+			var strings = new MetadataStrings();
+			var types = new List<TypeMetadata>();
+			var methods = new List<MethodMetadata>();
+			var parameters = new List<ManagedType>();
+			var attributes = new List<AttributeMetadata>();
+
+			foreach (Type type in assembly.GetTypes())
+			{
+				var typeData = new TypeMetadata
+				{
+					Handle = CachedTypes.Add(type),
+					Name = strings.Add(type.FullName),
+					BaseName = strings.Add(type.BaseType?.FullName),
+					FirstMethod = methods.Count,
+					FirstAttribute = attributes.Count
+				};
+
+				AddAttributes(type.GetCustomAttributesData(), attributes, strings);
+				typeData.AttributeCount = attributes.Count - typeData.FirstAttribute;
+
+				foreach (var method in type.GetMethods(BindingFlags.Public | BindingFlags.NonPublic | BindingFlags.Instance | BindingFlags.Static))
+				{
+					var resultType = AsyncExports.GetResultType(method.ReturnType);
+					var methodData = new MethodMetadata
+					{
+						Handle = CachedMethods.Add(method),
+						Name = strings.Add(method.Name),
+						ReturnType = new ManagedType(resultType ?? method.ReturnType),
+						Accessibility = (byte)GetTypeAccessibility(method),
+						IsStatic = method.IsStatic,
+						IsAsync = resultType != null,
+						FirstParameter = parameters.Count,
+						FirstAttribute = attributes.Count
+					};
+
+					foreach (var parameter in method.GetParameters())
+					{
+						parameters.Add(new ManagedType(parameter.ParameterType));
+					}
+					methodData.ParameterCount = parameters.Count - methodData.FirstParameter;
+
+					AddAttributes(method.GetCustomAttributesData(), attributes, strings);
+					methodData.AttributeCount = attributes.Count - methodData.FirstAttribute;
+
+					methods.Add(methodData);
+				}
+
+				typeData.MethodCount = methods.Count - typeData.FirstMethod;
+				types.Add(typeData);
+			}
+
+			var header = new MetadataHeader
+			{
+				Magic = MetadataMagic,
+				Version = MetadataVersion,
+				TypeCount = types.Count,
+				MethodCount = methods.Count,
+				ParameterCount = parameters.Count,
+				AttributeCount = attributes.Count,
+				StringsSize = strings.Bytes.Length
+			};
+
+			header.TypesOffset = AlignSection(sizeof(MetadataHeader));
+			header.MethodsOffset = AlignSection(header.TypesOffset + types.Count * sizeof(TypeMetadata));
+			header.AttributesOffset = AlignSection(header.MethodsOffset + methods.Count * sizeof(MethodMetadata));
+			header.ParametersOffset = AlignSection(header.AttributesOffset + attributes.Count * sizeof(AttributeMetadata));
+			header.StringsOffset = header.ParametersOffset + parameters.Count * sizeof(ManagedType);
+			int size = header.StringsOffset + header.StringsSize;
+
+			byte* buffer = (byte*)Marshal.AllocCoTaskMem(size);
+			*(MetadataHeader*)buffer = header;
+			WriteSection(buffer, header.TypesOffset, types);
+			WriteSection(buffer, header.MethodsOffset, methods);
+			WriteSection(buffer, header.AttributesOffset, attributes);
+			WriteSection(buffer, header.ParametersOffset, parameters);
+			strings.Bytes.CopyTo(new Span<byte>(buffer + header.StringsOffset, header.StringsSize));
+
+			*outSize = size;
+			return buffer;
+		}
+		catch (Exception e)
+		{
+			HandleException(e);
+			return null;
+		}
+	}
+
+	#endregion
 }
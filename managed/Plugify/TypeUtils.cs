@@ -187,6 +187,53 @@ internal static class TypeUtils
         [typeof(Matrix4x4)] = ValueType.Matrix4x4
     };
 
+    // Element types laid out exactly like their native counterpart, a plg::vector of them can be viewed in place
+    private static readonly HashSet<Type> SpanElementTypes =
+    [
+        typeof(Char8), typeof(Char16),
+        typeof(sbyte), typeof(short), typeof(int), typeof(long),
+        typeof(byte), typeof(ushort), typeof(uint), typeof(ulong),
+        typeof(nint), typeof(float), typeof(double),
+        typeof(Vector2), typeof(Vector3), typeof(Vector4), typeof(Matrix4x4)
+    ];
+
+    /// <summary>
+    /// Element type of a Span&lt;T&gt; or ReadOnlySpan&lt;T&gt; that can view a native vector, null for any other type.
+    /// </summary>
+    public static Type? GetSpanElementType(this Type type)
+    {
+        if (!type.IsGenericType)
+            return null;
+
+        var definition = type.GetGenericTypeDefinition();
+        if (definition != typeof(Span<>) && definition != typeof(ReadOnlySpan<>))
+            return null;
+
+        var elementType = type.GetGenericArguments()[0];
+        return SpanElementTypes.Contains(elementType) ? elementType : null;
+    }
+
+    /// <summary>
+    /// Element type of a NativeVector&lt;T&gt; over a by-ref native vector, null for any other type.
+    /// </summary>
+    public static Type? GetNativeVectorElementType(this Type type)
+    {
+        if (!type.IsGenericType || type.GetGenericTypeDefinition() != typeof(NativeVector<>))
+            return null;
+
+        var elementType = type.GetGenericArguments()[0];
+        return SpanElementTypes.Contains(elementType) ? elementType : null;
+    }
+
+    /// <summary>
+    /// True for a ref struct such as a Span&lt;T&gt;, NativeVector&lt;T&gt; or NativeStringView, also when taken by reference.
+    /// Only export thunks know how to build those, every boxing or array marshalling path has to refuse them.
+    /// </summary>
+    public static bool IsViewType(this Type type)
+    {
+        return (type.IsByRef ? type.GetElementType()! : type).IsByRefLike;
+    }
+
     public static ValueType ToValueType(this Type type)
     {
         var baseType = type.IsByRef ? type.GetElementType()! : type;
@@ -194,6 +241,21 @@ internal static class TypeUtils
         if (baseType.IsEnum)
         {
             baseType = baseType.GetEnumUnderlyingType();
+        }
+        else if (!type.IsByRef && baseType.GetSpanElementType() is { } spanElementType)
+        {
+            // Passed like the matching array, the span views the vector instead of copying it
+            baseType = spanElementType.MakeArrayType();
+        }
+        else if (!type.IsByRef && baseType.GetNativeVectorElementType() is { } vectorElementType)
+        {
+            // Stands for the by-ref array, edited in place instead of copied in and back out
+            baseType = vectorElementType.MakeArrayType();
+        }
+        else if (!type.IsByRef && baseType == typeof(NativeStringView))
+        {
+            // Passed like a string, the view reads the UTF-8 bytes in place
+            baseType = typeof(string);
         }
 		else if (baseType.IsArray)
 		{
@@ -0,0 +1,23 @@
+namespace Plugify;
+
+public static class UpdateScheduler
+{
+    /// <summary>
+    /// Time the plugin updates of one frame may take. Plugins marked with <see cref="DeferrableUpdateAttribute"/>
+    /// that don't fit are spread over the following frames, the others always run. Zero, the default, disables
+    /// the budget and every deferrable plugin updates each frame.
+    /// </summary>
+    public static TimeSpan FrameBudget { get; set; } = TimeSpan.Zero;
+
+    /// <summary>
+    /// Time the continuations queued on <see cref="MainThreadSynchronizationContext"/> may take each frame, the rest
+    /// resume on the next one. Zero runs all that were queued when the frame started.
+    /// </summary>
+    public static TimeSpan ContinuationBudget { get; set; } = TimeSpan.Zero;
+
+    /// <summary>
+    /// Moving average of the time the plugin's OnPluginUpdate took, the estimate <see cref="FrameBudget"/> is checked
+    /// against. Zero until the update first ran, or when the plugin isn't ticked by the batched update pass.
+    /// </summary>
+    public static TimeSpan GetAverageUpdateCost(Plugin plugin) => PluginUpdater.GetAverageCost(plugin);
+}
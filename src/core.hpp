@@ -32,8 +32,12 @@ namespace netlm {
 
 	using ManagedHandle = void*;
 
+	// Signature-specialized managed entry point: (void** params, void* result)
+	using ExportThunk = void(*)(const void**, void*);
+
 	struct InternalCall {
-		const char_t* name;
+		const char_t* typeName;
+		const char_t* fieldName;
 		void* nativeFunctionPtr;
 	};
 }
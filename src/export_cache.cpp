@@ -0,0 +1,185 @@
+#include "export_cache.hpp"
+
+#include <plugify/method.hpp>
+
+#include <fstream>
+
+using namespace netlm;
+
+static constexpr uint64_t FnvOffsetBasis = 14695981039346656037ULL;
+static constexpr uint64_t FnvPrime = 1099511628211ULL;
+
+static uint64_t HashBytes(uint64_t hash, const void* data, size_t size) {
+	const auto* bytes = static_cast<const uint8_t*>(data);
+	for (size_t i = 0; i < size; ++i) {
+		hash ^= bytes[i];
+		hash *= FnvPrime;
+	}
+	return hash;
+}
+
+template<typename T>
+static void Write(std::vector<char>& buffer, const T& value) {
+	const auto* bytes = reinterpret_cast<const char*>(&value);
+	buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+}
+
+template<typename T>
+static bool Read(std::span<const char>& buffer, T& value) {
+	if (buffer.size() < sizeof(T)) {
+		return false;
+	}
+	std::memcpy(&value, buffer.data(), sizeof(T));
+	buffer = buffer.subspan(sizeof(T));
+	return true;
+}
+
+static void Write(std::vector<char>& buffer, const LifecycleBinding& binding) {
+	Write(buffer, binding.token);
+	Write(buffer, static_cast<uint8_t>(binding.error));
+}
+
+static bool Read(std::span<const char>& buffer, LifecycleBinding& binding) {
+	uint8_t error = 0;
+	if (!Read(buffer, binding.token) || !Read(buffer, error)) {
+		return false;
+	}
+	binding.error = error != 0;
+	return true;
+}
+
+FileStamp FileStamp::Of(const fs::path& path) {
+	std::error_code ec;
+	auto size = fs::file_size(path, ec);
+	if (ec) {
+		return {};
+	}
+	auto writeTime = fs::last_write_time(path, ec);
+	if (ec) {
+		return {};
+	}
+	return { static_cast<uint64_t>(size), static_cast<int64_t>(writeTime.time_since_epoch().count()) };
+}
+
+// Plugify.Generators computes the same hash for every stub it emits, so keep both sides byte for byte alike
+uint64_t ExportCache::HashSignature(const plugify::Method& method) {
+	auto hashProperty = [](uint64_t hash, const plugify::Property& property) {
+		auto type = static_cast<uint8_t>(property.GetType());
+		auto ref = static_cast<uint8_t>(property.IsRef());
+		hash = HashBytes(hash, &type, sizeof(type));
+		return HashBytes(hash, &ref, sizeof(ref));
+	};
+
+	uint64_t hash = hashProperty(FnvOffsetBasis, method.GetRetType());
+	for (const auto& param : method.GetParamTypes()) {
+		hash = hashProperty(hash, param);
+	}
+	return hash;
+}
+
+bool ExportCache::Load(const fs::path& path) {
+	std::ifstream file(path, std::ios::binary | std::ios::ate);
+	if (!file) {
+		return false;
+	}
+
+	std::vector<char> data(static_cast<size_t>(file.tellg()));
+	file.seekg(0);
+	if (!file.read(data.data(), static_cast<std::streamsize>(data.size()))) {
+		return false;
+	}
+
+	std::span<const char> buffer(data);
+
+	uint32_t magic = 0, version = 0;
+	ManagedGuid mvid{};
+	FileStamp stamp{};
+	if (!Read(buffer, magic) || !Read(buffer, version) || magic != ExportCacheMagic || version != ExportCacheVersion) {
+		return false;
+	}
+	if (!Read(buffer, mvid) || !Read(buffer, stamp.size) || !Read(buffer, stamp.writeTime) || mvid != _mvid || stamp != _stamp) {
+		return false;
+	}
+
+	PluginBinding plugin{};
+	uint32_t exportCount = 0;
+	if (!Read(buffer, plugin.typeToken) || !Read(buffer, plugin.update) || !Read(buffer, plugin.start) || !Read(buffer, plugin.end) || !Read(buffer, exportCount)) {
+		return false;
+	}
+
+	// Every record holds at least its name length and binding, so a count the rest of the file can't hold is corrupt
+	constexpr size_t kMinRecordSize = sizeof(uint32_t) + sizeof(ExportBinding::signature) + sizeof(ExportBinding::typeToken) + sizeof(ExportBinding::methodToken);
+	if (exportCount > buffer.size() / kMinRecordSize) {
+		return false;
+	}
+
+	StringMap<ExportBinding> exports;
+	exports.reserve(exportCount);
+	for (uint32_t i = 0; i < exportCount; ++i) {
+		uint32_t nameLength = 0;
+		if (!Read(buffer, nameLength) || buffer.size() < nameLength) {
+			return false;
+		}
+		std::string funcName(buffer.data(), nameLength);
+		buffer = buffer.subspan(nameLength);
+
+		ExportBinding binding{};
+		if (!Read(buffer, binding.signature) || !Read(buffer, binding.typeToken) || !Read(buffer, binding.methodToken)) {
+			return false;
+		}
+		exports.try_emplace(std::move(funcName), binding);
+	}
+
+	_plugin = plugin;
+	_exports = std::move(exports);
+	return true;
+}
+
+bool ExportCache::Save(const fs::path& path) const {
+	std::vector<char> buffer;
+	Write(buffer, ExportCacheMagic);
+	Write(buffer, ExportCacheVersion);
+	Write(buffer, _mvid);
+	Write(buffer, _stamp.size);
+	Write(buffer, _stamp.writeTime);
+	Write(buffer, _plugin.typeToken);
+	Write(buffer, _plugin.update);
+	Write(buffer, _plugin.start);
+	Write(buffer, _plugin.end);
+	Write(buffer, static_cast<uint32_t>(_exports.size()));
+	for (const auto& [funcName, binding] : _exports) {
+		Write(buffer, static_cast<uint32_t>(funcName.size()));
+		buffer.insert(buffer.end(), funcName.begin(), funcName.end());
+		Write(buffer, binding.signature);
+		Write(buffer, binding.typeToken);
+		Write(buffer, binding.methodToken);
+	}
+
+	std::error_code ec;
+	fs::create_directories(path.parent_path(), ec);
+
+	// Written aside and renamed, so a crash mid-write never leaves a truncated cache behind
+	fs::path tempPath(path);
+	tempPath += ".tmp";
+	{
+		std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+		if (!file || !file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()))) {
+			return false;
+		}
+	}
+
+	fs::rename(tempPath, path, ec);
+	return !ec;
+}
+
+const ExportBinding* ExportCache::FindExport(std::string_view funcName, uint64_t signature) const {
+	auto it = _exports.find(funcName);
+	if (it == _exports.end() || it->second.signature != signature) {
+		return nullptr;
+	}
+	return &it->second;
+}
+
+void ExportCache::AddExport(std::string_view funcName, const ExportBinding& binding) {
+	_exports.insert_or_assign(std::string(funcName), binding);
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "core.hpp"
+#include "utils.hpp"
+
+namespace plugify {
+	class Method;
+}
+
+namespace netlm {
+	constexpr uint32_t ExportCacheMagic = 0x45474C50; // "PLGE"
+	constexpr uint32_t ExportCacheVersion = 2;
+
+	/// Type and method of an export, saved once its signature passed validation.
+	struct ExportBinding {
+		uint64_t signature;
+		int32_t typeToken;
+		int32_t methodToken;
+	};
+
+	/// Lifecycle method of the plugin class, token is 0 when the class doesn't define it.
+	struct LifecycleBinding {
+		int32_t token;
+		bool error; // returns System.String
+	};
+
+	/// Size and write time of the assembly, read from the file system without touching its contents.
+	struct FileStamp {
+		uint64_t size;
+		int64_t writeTime;
+
+		static FileStamp Of(const fs::path& path);
+
+		bool operator==(const FileStamp&) const = default;
+	};
+
+	struct PluginBinding {
+		int32_t typeToken;
+		LifecycleBinding update;
+		LifecycleBinding start;
+		LifecycleBinding end;
+	};
+
+	/// Resolved export table of a plugin, stored as metadata tokens since handles don't survive a restart.
+	/// Keyed by the assembly MVID, which every compile regenerates, and by its file stamp, so a rebuilt assembly
+	/// never reads the bindings of an older one.
+	class ExportCache {
+	public:
+		ExportCache(ManagedGuid mvid, FileStamp stamp) : _mvid{mvid}, _stamp{stamp} {}
+
+		static uint64_t HashSignature(const plugify::Method& method);
+
+		bool Load(const fs::path& path);
+		bool Save(const fs::path& path) const;
+
+		const PluginBinding& GetPluginBinding() const { return _plugin; }
+		void SetPluginBinding(const PluginBinding& binding) { _plugin = binding; }
+
+		const ExportBinding* FindExport(std::string_view funcName, uint64_t signature) const;
+		void AddExport(std::string_view funcName, const ExportBinding& binding);
+
+	private:
+		ManagedGuid _mvid{};
+		FileStamp _stamp{};
+		PluginBinding _plugin{};
+		StringMap<ExportBinding> _exports;
+	};
+}
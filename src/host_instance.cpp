@@ -273,118 +273,19 @@ Res<void*> HostInstance::GetDelegate(const char_t* assemblyPath, const char_t* t
 }
 
 Res<void> HostInstance::LoadManagedFunctions(const fs::path& assemblyPath) {
-    const char_t* path = assemblyPath.c_str();
-
-    // Define a macro to simplify delegate loading and checking
-    #define LOAD_DELEGATE(field, typeName, methodName) \
-        do { \
-            auto result = GetDelegate(path, typeName, methodName); \
-            if (!result) { \
-                return std::unexpected(result.error()); \
-            } \
-            Managed.field = reinterpret_cast<decltype(Managed.field)>(result.value()); \
-        } while(0)
-
-    // Core functions
-    LOAD_DELEGATE(InitializeFptr, NETLM_NSTR("Plugify.ManagedHost, Plugify"), NETLM_NSTR("Initialize"));
-    LOAD_DELEGATE(ShutdownFptr, NETLM_NSTR("Plugify.ManagedHost, Plugify"), NETLM_NSTR("Shutdown"));
-
-    // Assembly loading functions
-    LOAD_DELEGATE(LoadManagedAssemblyFptr, NETLM_NSTR("Plugify.AssemblyLoader, Plugify"), NETLM_NSTR("LoadAssembly"));
-    LOAD_DELEGATE(UnloadManagedAssemblyFptr, NETLM_NSTR("Plugify.AssemblyLoader, Plugify"), NETLM_NSTR("UnloadAssembly"));
-    LOAD_DELEGATE(GetLastLoadStatusFptr, NETLM_NSTR("Plugify.AssemblyLoader, Plugify"), NETLM_NSTR("GetLastLoadStatus"));
-    LOAD_DELEGATE(GetAssemblyNameFptr, NETLM_NSTR("Plugify.AssemblyLoader, Plugify"), NETLM_NSTR("GetAssemblyName"));
-
-    // Type interface functions
-    LOAD_DELEGATE(GetAssemblyTypesFptr, NETLM_NSTR("Plugify.TypeInterface, Plugify"), NETLM_NSTR("GetAssemblyTypes"));
-    LOAD_DELEGATE(GetTypeFptr, NETLM_NSTR("Plugify.TypeInterface, Plugify"), NETLM_NSTR("GetType"));
-    LOAD_DELEGATE(GetFullTypeNameFptr, NETLM_NSTR("Plugify.TypeInterface, Plugify"), NETLM_NSTR("GetFullTypeName"));
-    LOAD_DELEGATE(GetAssemblyQualifiedNameFptr, NETLM_NSTR("Plugify.TypeInterface, Plugify"), NETLM_NSTR("GetAssemblyQualifiedName"));
-    LOAD_DELEGATE(GetBaseTypeFptr, NETLM_NSTR("Plugify.TypeInterface, Plugify"), NETLM_NSTR("GetBaseType"));
-    LOAD_DELEGATE(GetTypeSizeFptr, NETLM_NSTR("Plugify.TypeInterface, Plugify"), NETLM_NSTR("GetTypeSize"));
-    LOAD_DELEGATE(IsTypeSubclassOfFptr, NETLM_NSTR("Plugify.TypeInterface, Plugify"), NETLM_NSTR("IsTypeSubclassOf"));
-    LOAD_DELEGATE(IsTypeAssignableToFptr, NETLM_NSTR("Plugify.TypeInterface, Plugify"), NETLM_NSTR("IsTypeAssignableTo"));
-    LOAD_DELEGATE(IsTypeAssignableFromFptr, NETLM_NSTR("Plugify.TypeInterface, Plugify"), NETLM_NSTR("IsTypeAssignableFrom"));
-    LOAD_DELEGATE(IsTypeSZArrayFptr, NETLM_NSTR("Plugify.TypeInterface, Plugify"), NETLM_NSTR("IsTypeSZArray"));
-    LOAD_DELEGATE(IsTypeByRefFptr, NETLM_NSTR("Plugify.TypeInterface, Plugify"), NETLM_NSTR("IsTypeByRef"));
-    LOAD_DELEGATE(GetElementTypeFptr, NETLM_NSTR("Plugify.TypeInterface, Plugify"), NETLM_NSTR("GetElementType"));
-
-    // Method/Field/Property functions
-    LOAD_DELEGATE(GetTypeMethodsFptr, NETLM_NSTR("Plugify.TypeInterface, Plugify"), NETLM_NSTR("GetTypeMethods"));
-    LOAD_DELEGATE(GetTypeFieldsFptr, NETLM_NSTR("Plugify.TypeInterface, Plugify"), NETLM_NSTR("GetTypeFields"));
-    LOAD_DELEGATE(GetTypePropertiesFptr, NETLM_NSTR("Plugify.TypeInterface, Plugify"), NETLM_NSTR("GetTypeProperties"));
-    LOAD_DELEGATE(GetTypeMethodFptr, NETLM_NSTR("Plugify.TypeInterface, Plugify"), NETLM_NSTR("GetTypeMethod"));
-    LOAD_DELEGATE(GetTypeFieldFptr, NETLM_NSTR("Plugify.TypeInterface, Plugify"), NETLM_NSTR("GetTypeField"));
-    LOAD_DELEGATE(GetTypePropertyFptr, NETLM_NSTR("Plugify.TypeInterface, Plugify"), NETLM_NSTR("GetTypeProperty"));
-
-    // Attribute functions
-    LOAD_DELEGATE(HasTypeAttributeFptr, NETLM_NSTR("Plugify.TypeInterface, Plugify"), NETLM_NSTR("HasTypeAttribute"));
-    LOAD_DELEGATE(GetTypeAttributesFptr, NETLM_NSTR("Plugify.TypeInterface, Plugify"), NETLM_NSTR("GetTypeAttributes"));
-    LOAD_DELEGATE(GetTypeManagedTypeFptr, NETLM_NSTR("Plugify.TypeInterface, Plugify"), NETLM_NSTR("GetTypeManagedType"));
-
-    // Static method invocation
-    LOAD_DELEGATE(InvokeStaticMethodFptr, NETLM_NSTR("Plugify.ManagedObject, Plugify"), NETLM_NSTR("InvokeStaticMethod"));
-    LOAD_DELEGATE(InvokeStaticMethodRetFptr, NETLM_NSTR("Plugify.ManagedObject, Plugify"), NETLM_NSTR("InvokeStaticMethodRet"));
-
-    // MethodInfo functions
-    LOAD_DELEGATE(GetMethodInfoNameFptr, NETLM_NSTR("Plugify.TypeInterface, Plugify"), NETLM_NSTR("GetMethodInfoName"));
-    LOAD_DELEGATE(GetMethodInfoFunctionAddressFptr, NETLM_NSTR("Plugify.TypeInterface, Plugify"), NETLM_NSTR("GetMethodInfoFunctionAddress"));
-    LOAD_DELEGATE(GetMethodInfoReturnTypeFptr, NETLM_NSTR("Plugify.TypeInterface, Plugify"), NETLM_NSTR("GetMethodInfoReturnType"));
-    LOAD_DELEGATE(GetMethodInfoParameterTypesFptr, NETLM_NSTR("Plugify.TypeInterface, Plugify"), NETLM_NSTR("GetMethodInfoParameterTypes"));
-    LOAD_DELEGATE(GetMethodInfoAccessibilityFptr, NETLM_NSTR("Plugify.TypeInterface, Plugify"), NETLM_NSTR("GetMethodInfoAccessibility"));
-    LOAD_DELEGATE(GetMethodInfoAttributesFptr, NETLM_NSTR("Plugify.TypeInterface, Plugify"), NETLM_NSTR("GetMethodInfoAttributes"));
-    LOAD_DELEGATE(GetMethodInfoParameterAttributesFptr, NETLM_NSTR("Plugify.TypeInterface, Plugify"), NETLM_NSTR("GetMethodInfoParameterAttributes"));
-    LOAD_DELEGATE(GetMethodInfoReturnAttributesFptr, NETLM_NSTR("Plugify.TypeInterface, Plugify"), NETLM_NSTR("GetMethodInfoReturnAttributes"));
-
-    // FieldInfo functions
-    LOAD_DELEGATE(GetFieldInfoNameFptr, NETLM_NSTR("Plugify.TypeInterface, Plugify"), NETLM_NSTR("GetFieldInfoName"));
-    LOAD_DELEGATE(GetFieldInfoTypeFptr, NETLM_NSTR("Plugify.TypeInterface, Plugify"), NETLM_NSTR("GetFieldInfoType"));
-    LOAD_DELEGATE(GetFieldInfoAccessibilityFptr, NETLM_NSTR("Plugify.TypeInterface, Plugify"), NETLM_NSTR("GetFieldInfoAccessibility"));
-    LOAD_DELEGATE(GetFieldInfoAttributesFptr, NETLM_NSTR("Plugify.TypeInterface, Plugify"), NETLM_NSTR("GetFieldInfoAttributes"));
-
-    // PropertyInfo functions
-    LOAD_DELEGATE(GetPropertyInfoNameFptr, NETLM_NSTR("Plugify.TypeInterface, Plugify"), NETLM_NSTR("GetPropertyInfoName"));
-    LOAD_DELEGATE(GetPropertyInfoTypeFptr, NETLM_NSTR("Plugify.TypeInterface, Plugify"), NETLM_NSTR("GetPropertyInfoType"));
-    LOAD_DELEGATE(GetPropertyInfoAttributesFptr, NETLM_NSTR("Plugify.TypeInterface, Plugify"), NETLM_NSTR("GetPropertyInfoAttributes"));
-
-    // Attribute functions
-    LOAD_DELEGATE(GetAttributeFieldValueFptr, NETLM_NSTR("Plugify.TypeInterface, Plugify"), NETLM_NSTR("GetAttributeFieldValue"));
-    LOAD_DELEGATE(GetAttributeTypeFptr, NETLM_NSTR("Plugify.TypeInterface, Plugify"), NETLM_NSTR("GetAttributeType"));
-
-    // Interop and object management
-    LOAD_DELEGATE(SetInternalCallsFptr, NETLM_NSTR("Plugify.Interop.InternalCallsManager, Plugify"), NETLM_NSTR("SetInternalCalls"));
-    LOAD_DELEGATE(CreateObjectFptr, NETLM_NSTR("Plugify.ManagedObject, Plugify"), NETLM_NSTR("CreateObject"));
-    LOAD_DELEGATE(InvokeMethodFptr, NETLM_NSTR("Plugify.ManagedObject, Plugify"), NETLM_NSTR("InvokeMethod"));
-    LOAD_DELEGATE(InvokeMethodRetFptr, NETLM_NSTR("Plugify.ManagedObject, Plugify"), NETLM_NSTR("InvokeMethodRet"));
-    LOAD_DELEGATE(InvokeDelegateFptr, NETLM_NSTR("Plugify.ManagedObject, Plugify"), NETLM_NSTR("InvokeDelegate"));
-    LOAD_DELEGATE(InvokeDelegateRetFptr, NETLM_NSTR("Plugify.ManagedObject, Plugify"), NETLM_NSTR("InvokeDelegateRet"));
-
-    // Field operations
-    LOAD_DELEGATE(SetFieldValueFptr, NETLM_NSTR("Plugify.ManagedObject, Plugify"), NETLM_NSTR("SetFieldValue"));
-    LOAD_DELEGATE(GetFieldValueFptr, NETLM_NSTR("Plugify.ManagedObject, Plugify"), NETLM_NSTR("GetFieldValue"));
-    LOAD_DELEGATE(GetFieldPointerFptr, NETLM_NSTR("Plugify.ManagedObject, Plugify"), NETLM_NSTR("GetFieldPointer"));
-
-    // Property operations
-    LOAD_DELEGATE(SetPropertyValueFptr, NETLM_NSTR("Plugify.ManagedObject, Plugify"), NETLM_NSTR("SetPropertyValue"));
-    LOAD_DELEGATE(GetPropertyValueFptr, NETLM_NSTR("Plugify.ManagedObject, Plugify"), NETLM_NSTR("GetPropertyValue"));
-
-    // Object lifecycle
-    LOAD_DELEGATE(DestroyObjectFptr, NETLM_NSTR("Plugify.ManagedObject, Plugify"), NETLM_NSTR("DestroyObject"));
-
-    // Garbage collection
-    LOAD_DELEGATE(CollectGarbageFptr, NETLM_NSTR("Plugify.GarbageCollector, Plugify"), NETLM_NSTR("CollectGarbage"));
-    LOAD_DELEGATE(WaitForPendingFinalizersFptr, NETLM_NSTR("Plugify.GarbageCollector, Plugify"), NETLM_NSTR("WaitForPendingFinalizers"));
-
-    // Type checking functions
-    LOAD_DELEGATE(IsClassFptr, NETLM_NSTR("Plugify.TypeInterface, Plugify"), NETLM_NSTR("IsClass"));
-    LOAD_DELEGATE(IsEnumFptr, NETLM_NSTR("Plugify.TypeInterface, Plugify"), NETLM_NSTR("IsEnum"));
-    LOAD_DELEGATE(IsValueTypeFptr, NETLM_NSTR("Plugify.TypeInterface, Plugify"), NETLM_NSTR("IsValueType"));
-
-    // Enum functions
-    LOAD_DELEGATE(GetEnumNamesFptr, NETLM_NSTR("Plugify.TypeInterface, Plugify"), NETLM_NSTR("GetEnumNames"));
-    LOAD_DELEGATE(GetEnumValuesFptr, NETLM_NSTR("Plugify.TypeInterface, Plugify"), NETLM_NSTR("GetEnumValues"));
-
-    #undef LOAD_DELEGATE
+    // Only the bootstrap goes through hostfxr, it fills the rest of the table in one transition
+    auto result = GetDelegate(assemblyPath.c_str(), NETLM_NSTR("Plugify.ManagedHost, Plugify"), NETLM_NSTR("Bootstrap"));
+    if (!result) {
+        return std::unexpected(result.error());
+    }
+
+    static_assert(sizeof(ManagedFunctions) % sizeof(void*) == 0, "ManagedFunctions must only hold function pointers");
+    constexpr int32_t functionCount = static_cast<int32_t>(sizeof(ManagedFunctions) / sizeof(void*));
+
+    auto bootstrap = reinterpret_cast<BootstrapFn>(result.value());
+    if (!bootstrap(reinterpret_cast<void**>(&Managed), functionCount, ManagedFunctionsVersion)) {
+        return std::unexpected(std::format("Plugify.dll does not match the module (expected function table v{} with {} entries)", ManagedFunctionsVersion, functionCount));
+    }
 
     return {};
 }
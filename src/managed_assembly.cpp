@@ -12,6 +12,7 @@ static Type InvalidType{InvalidHandle};
 
 void AssemblyLoader::Unload() {
 	for (auto it = _assemblies.rbegin(); it != _assemblies.rend(); ++it) {
+		TypeCache::Get().Remove(it->GetID());
 		[[maybe_unused]] Bool32 result = Managed.UnloadManagedAssemblyFptr(it->GetID());
 	}
 
@@ -54,6 +55,20 @@ ManagedAssembly& AssemblyLoader::LoadAssembly(const fs::path& assemblyPath) {
 	return _assemblies.emplace_back(id);
 }
 
+void AssemblyLoader::UnloadAssembly(ManagedGuid assemblyId) {
+	auto it = std::find_if(_assemblies.begin(), _assemblies.end(), [&assemblyId](const ManagedAssembly& assembly) {
+		return assembly.GetID() == assemblyId;
+	});
+
+	if (it == _assemblies.end()) {
+		return;
+	}
+
+	TypeCache::Get().Remove(assemblyId);
+	[[maybe_unused]] Bool32 result = Managed.UnloadManagedAssemblyFptr(assemblyId);
+	_assemblies.erase(it);
+}
+
 ManagedAssembly& AssemblyLoader::FindAssembly(ManagedGuid assemblyId) {
 	auto it = std::find_if(_assemblies.begin(), _assemblies.end(), [&assemblyId](const ManagedAssembly& assembly) {
 		return assembly.GetID() == assemblyId;
@@ -73,59 +88,117 @@ std::string ManagedAssembly::GetFullName() const {
 	return str;
 }
 
+std::vector<void*> ManagedAssembly::GetExports(const std::vector<std::string_view>& funcNames, std::vector<uint64_t>& signatures) const {
+	std::vector<String> names;
+	names.reserve(funcNames.size());
+	for (const auto& funcName : funcNames) {
+		names.emplace_back(String::New(funcName));
+	}
+
+	std::vector<void*> exports(funcNames.size());
+	signatures.assign(funcNames.size(), 0);
+	Managed.GetAssemblyExportsFptr(_id, names.data(), exports.data(), signatures.data(), static_cast<int32_t>(names.size()));
+
+	for (auto& name : names) {
+		String::Free(name);
+	}
+	return exports;
+}
+
+ManagedGuid ManagedAssembly::GetModuleVersionId() const {
+	ManagedGuid mvid{};
+	Managed.GetAssemblyModuleVersionIdFptr(_id, &mvid);
+	return mvid;
+}
+
+int32_t ManagedAssembly::GetMetadataToken(const Type& type) const {
+	return Managed.GetTypeMetadataTokenFptr(_id, type.GetHandle());
+}
+
+int32_t ManagedAssembly::GetMetadataToken(const MethodInfo& method) const {
+	return Managed.GetMethodInfoMetadataTokenFptr(_id, method.GetHandle());
+}
+
+bool ManagedAssembly::ResolveMetadataTokens(const std::vector<int32_t>& tokens, std::vector<ManagedHandle>& handles) const {
+	handles.resize(tokens.size());
+	return Managed.ResolveMetadataTokensFptr(_id, tokens.data(), handles.data(), static_cast<int32_t>(tokens.size()));
+}
+
 const std::vector<Type*>& ManagedAssembly::GetTypes() {
 	if (!_types) {
 		_types.emplace();
 
+		// Names come along with the handles, so lookups below never go back to managed
 		int32_t typeCount = 0;
-		Managed.GetAssemblyTypesFptr(_id, nullptr, &typeCount);
+		Managed.GetAssemblyTypeNamesFptr(_id, nullptr, nullptr, nullptr, &typeCount);
 		std::vector<ManagedHandle> typeHandles(static_cast<size_t>(typeCount));
-		Managed.GetAssemblyTypesFptr(_id, typeHandles.data(), &typeCount);
+		std::vector<String> typeNames(static_cast<size_t>(typeCount));
+		std::vector<String> baseTypeNames(static_cast<size_t>(typeCount));
+		Managed.GetAssemblyTypeNamesFptr(_id, typeHandles.data(), typeNames.data(), baseTypeNames.data(), &typeCount);
 
 		_types->reserve(typeHandles.size());
-		for (auto typeHandle : typeHandles) {
-			_types->emplace_back(TypeCache::Get().Add(typeHandle));
+		_typesByName.reserve(typeHandles.size());
+		for (size_t i = 0; i < typeHandles.size(); ++i) {
+			Type* type = _types->emplace_back(TypeCache::Get().Add(typeHandles[i]));
+
+			// First match wins, same as the linear scan
+			if (!typeNames[i].IsNull()) {
+				_typesByName.try_emplace(std::string(typeNames[i]), type);
+			}
+			if (!baseTypeNames[i].IsNull()) {
+				_typesByBaseName.try_emplace(std::string(baseTypeNames[i]), type);
+			}
+
+			String::Free(typeNames[i]);
+			String::Free(baseTypeNames[i]);
 		}
 	}
 	return *_types;
 }
 
+const MetadataSnapshot& ManagedAssembly::GetMetadataSnapshot() {
+	if (!_metadata) {
+		int32_t size = 0;
+		uint8_t* data = Managed.GetAssemblyMetadataFptr(_id, &size);
+		_metadata.emplace(data, static_cast<size_t>(size));
+	}
+	return *_metadata;
+}
+
 void ManagedAssembly::AddInternalCall(std::string_view className, std::string_view variableName, void* functionPtr) {
 	assert(functionPtr != nullptr);
 
-	std::string assemblyQualifiedName(std::format("{}@{}, {}", className, variableName, GetFullName()));
-
+	// Type and field go over pre-split, the type is looked up in this assembly only
 #if NETLM_PLATFORM_WINDOWS
-	const auto& name = _internalCallNameStorage.emplace_back(Utils::ConvertUtf8ToWide(assemblyQualifiedName));
+	const auto& typeName = _internalCallNameStorage.emplace_back(Utils::ConvertUtf8ToWide(className));
+	const auto& fieldName = _internalCallNameStorage.emplace_back(Utils::ConvertUtf8ToWide(variableName));
 #else
-	const auto& name = _internalCallNameStorage.emplace_back(std::move(assemblyQualifiedName));
+	const auto& typeName = _internalCallNameStorage.emplace_back(className);
+	const auto& fieldName = _internalCallNameStorage.emplace_back(variableName);
 #endif
 
-	_internalCalls.emplace_back(name.c_str(), functionPtr);
+	_internalCalls.emplace_back(typeName.c_str(), fieldName.c_str(), functionPtr);
 }
 
 void ManagedAssembly::UploadInternalCalls(bool warnOnMissing) {
+	if (_internalCalls.empty()) {
+		return;
+	}
 
-	Managed.SetInternalCallsFptr(_internalCalls.data(), static_cast<int32_t>(_internalCalls.size()), warnOnMissing);
+	Managed.SetInternalCallsFptr(_id, _internalCalls.data(), static_cast<int32_t>(_internalCalls.size()), warnOnMissing);
 
 	_internalCalls.clear();
 	_internalCallNameStorage.clear();
 }
 
 Type& ManagedAssembly::GetType(std::string_view className) {
-	for (auto& type : GetTypes()) {
-		if (type->GetFullName() == className) {
-			return *type;
-		}
-	}
-	return InvalidType;
+	GetTypes();
+	auto it = _typesByName.find(className);
+	return it != _typesByName.end() ? *it->second : InvalidType;
 }
 
 Type& ManagedAssembly::GetTypeByBaseType(std::string_view baseName) {
-	for (auto& type : GetTypes()) {
-		if (type->GetBaseType().GetFullName() == baseName) {
-			return *type;
-		}
-	}
-	return InvalidType;
+	GetTypes();
+	auto it = _typesByBaseName.find(baseName);
+	return it != _typesByBaseName.end() ? *it->second : InvalidType;
 }
@@ -1,7 +1,9 @@
 #pragma once
 
 #include "core.hpp"
+#include "metadata_snapshot.hpp"
 #include "type.hpp"
+#include "utils.hpp"
 
 namespace netlm {
 
@@ -21,6 +23,13 @@ namespace netlm {
 
 		ManagedGuid GetID() const { return _id; }
 		std::string GetFullName() const;
+		/// Generated stubs by function name, null where there is none. Each stub comes with the signature hash it was built for.
+		std::vector<void*> GetExports(const std::vector<std::string_view>& funcNames, std::vector<uint64_t>& signatures) const;
+
+		ManagedGuid GetModuleVersionId() const;
+		int32_t GetMetadataToken(const Type& type) const;
+		int32_t GetMetadataToken(const MethodInfo& method) const;
+		bool ResolveMetadataTokens(const std::vector<int32_t>& tokens, std::vector<ManagedHandle>& handles) const;
 
 		void AddInternalCall(std::string_view className, std::string_view variableName, void* functionPtr);
 		void UploadInternalCalls(bool warnOnMissing = true);
@@ -29,12 +38,17 @@ namespace netlm {
 		Type& GetType(std::string_view className);
 		Type& GetTypeByBaseType(std::string_view baseName);
 
+		const MetadataSnapshot& GetMetadataSnapshot();
+
 		bool operator==(const ManagedAssembly& other) const { return _id == other._id; }
 		explicit operator bool() const { return static_cast<bool>(_id); }
 
 	private:
 		ManagedGuid _id{};
 		std::optional<std::vector<Type*>> _types;
+		StringMap<Type*> _typesByName;
+		StringMap<Type*> _typesByBaseName;
+		std::optional<MetadataSnapshot> _metadata;
 		std::deque<string_t> _internalCallNameStorage;
 		std::vector<InternalCall> _internalCalls;
 	};
@@ -46,6 +60,7 @@ namespace netlm {
 		void Unload();
 
 		ManagedAssembly& LoadAssembly(const fs::path& assemblyPath);
+		void UnloadAssembly(ManagedGuid assemblyId);
 		ManagedAssembly& FindAssembly(ManagedGuid assemblyId);
 
 		AssemblyList& GetLoadedAssemblies() { return _assemblies; }
@@ -10,14 +10,23 @@ namespace netlm {
 	struct ManagedType;
 	class ManagedObject;
 
+	// Must be bumped together with ManagedHost.FunctionTableVersion whenever ManagedFunctions changes
+	constexpr int32_t ManagedFunctionsVersion = 8;
+
+	using BootstrapFn = Bool32(*)(void**, int32_t, int32_t);
 	using InitializeFn = void(*)(void(*)(String, MessageLevel), void(*)(String));
 	using ShutdownFn = void(*)();
 
-	using SetInternalCallsFn = void(*)(InternalCall*, int32_t, Bool32);
+	using SetInternalCallsFn = void(*)(ManagedGuid, InternalCall*, int32_t, Bool32);
 	using LoadManagedAssemblyFn = ManagedGuid(*)(String, Bool32, Bool32);
 	using UnloadManagedAssemblyFn = Bool32(*)(ManagedGuid);
 	using GetLastLoadStatusFn = AssemblyLoadStatus(*)();
 	using GetAssemblyNameFn = String(*)(ManagedGuid);
+	using GetAssemblyExportsFn = void(*)(ManagedGuid, const String*, void**, uint64_t*, int32_t);
+	using GetAssemblyModuleVersionIdFn = void(*)(ManagedGuid, ManagedGuid*);
+	using GetTypeMetadataTokenFn = int32_t(*)(ManagedGuid, ManagedHandle);
+	using GetMethodInfoMetadataTokenFn = int32_t(*)(ManagedGuid, ManagedHandle);
+	using ResolveMetadataTokensFn = Bool32(*)(ManagedGuid, const int32_t*, ManagedHandle*, int32_t);
 
 	using CollectGarbageFn = void(*)(int32_t, GCCollectionMode, Bool32, Bool32);
 	using WaitForPendingFinalizersFn = void(*)();
@@ -27,6 +36,8 @@ namespace netlm {
 	using InvokeMethodRetFn = void(*)(ManagedHandle, ManagedHandle, const void**, int32_t, void*);
 	using InvokeStaticMethodFn = void(*)(ManagedHandle, ManagedHandle, const void**, int32_t);
 	using InvokeStaticMethodRetFn = void(*)(ManagedHandle, ManagedHandle, const void**, int32_t, void*);
+	using GetExportThunkFn = ExportThunk(*)(ManagedHandle);
+	using InvokeExportBatchFn = void(*)(ManagedHandle, const void* const*, const uint32_t*, int32_t, int32_t, void*, int32_t);
 	using InvokeDelegateFn = void(*)(ManagedHandle, const void**, int32_t);
 	using InvokeDelegateRetFn = void(*)(ManagedHandle, const void**, int32_t, void*);
 	using SetFieldValueFn = void(*)(ManagedHandle, String, void*);
@@ -35,12 +46,19 @@ namespace netlm {
 	using SetPropertyValueFn = void(*)(ManagedHandle, String, void*);
 	using GetPropertyValueFn = void(*)(ManagedHandle, String, void*);
 	using DestroyObjectFn = void(*)(ManagedHandle);
+	using RegisterUpdateFn = Bool32(*)(ManagedHandle, ManagedHandle, String);
+	using UnregisterUpdateFn = void(*)(ManagedHandle);
+	using SetUpdateEnabledFn = void(*)(ManagedHandle, Bool32);
+	using UpdatePluginsFn = void(*)(float);
 
 #pragma region TypeInterface
 	using GetAssemblyTypesFn = void(*)(ManagedGuid, ManagedHandle*, int32_t*);
+	using GetAssemblyTypeNamesFn = void(*)(ManagedGuid, ManagedHandle*, String*, String*, int32_t*);
+	using GetAssemblyMetadataFn = uint8_t*(*)(ManagedGuid, int32_t*);
 	using GetTypeFn = void(*)(String, ManagedHandle*);
 	using GetFullTypeNameFn = String(*)(ManagedHandle);
 	using GetAssemblyQualifiedNameFn = String(*)(ManagedHandle);
+	using GetTypeAssemblyIdFn = ManagedGuid(*)(ManagedHandle);
 	using GetBaseTypeFn = void(*)(ManagedHandle, ManagedHandle*);
 	using GetTypeSizeFn = int32_t(*)(ManagedHandle);
 	using IsTypeSubclassOfFn = Bool32(*)(ManagedHandle, ManagedHandle);
@@ -106,6 +124,11 @@ namespace netlm {
 		UnloadManagedAssemblyFn UnloadManagedAssemblyFptr;
 		GetLastLoadStatusFn GetLastLoadStatusFptr;
 		GetAssemblyNameFn GetAssemblyNameFptr;
+		GetAssemblyExportsFn GetAssemblyExportsFptr;
+		GetAssemblyModuleVersionIdFn GetAssemblyModuleVersionIdFptr;
+		GetTypeMetadataTokenFn GetTypeMetadataTokenFptr;
+		GetMethodInfoMetadataTokenFn GetMethodInfoMetadataTokenFptr;
+		ResolveMetadataTokensFn ResolveMetadataTokensFptr;
 
 		CollectGarbageFn CollectGarbageFptr;
 		WaitForPendingFinalizersFn WaitForPendingFinalizersFptr;
@@ -115,6 +138,8 @@ namespace netlm {
 		InvokeMethodRetFn InvokeMethodRetFptr;
 		InvokeStaticMethodFn InvokeStaticMethodFptr;
 		InvokeStaticMethodRetFn InvokeStaticMethodRetFptr;
+		GetExportThunkFn GetExportThunkFptr;
+		InvokeExportBatchFn InvokeExportBatchFptr;
 		InvokeDelegateFn InvokeDelegateFptr;
 		InvokeDelegateRetFn InvokeDelegateRetFptr;
 		SetFieldValueFn SetFieldValueFptr;
@@ -123,12 +148,19 @@ namespace netlm {
 		SetPropertyValueFn SetPropertyValueFptr;
 		GetPropertyValueFn GetPropertyValueFptr;
 		DestroyObjectFn DestroyObjectFptr;
+		RegisterUpdateFn RegisterUpdateFptr;
+		UnregisterUpdateFn UnregisterUpdateFptr;
+		SetUpdateEnabledFn SetUpdateEnabledFptr;
+		UpdatePluginsFn UpdatePluginsFptr;
 		
 #pragma region TypeInterface
 		GetAssemblyTypesFn GetAssemblyTypesFptr;
+		GetAssemblyTypeNamesFn GetAssemblyTypeNamesFptr;
+		GetAssemblyMetadataFn GetAssemblyMetadataFptr;
 		GetTypeFn GetTypeFptr;
 		GetFullTypeNameFn GetFullTypeNameFptr;
 		GetAssemblyQualifiedNameFn GetAssemblyQualifiedNameFptr;
+		GetTypeAssemblyIdFn GetTypeAssemblyIdFptr;
 		GetBaseTypeFn GetBaseTypeFptr;
 		GetTypeSizeFn GetTypeSizeFptr;
 		IsTypeSubclassOfFn IsTypeSubclassOfFptr;
@@ -0,0 +1,91 @@
+#include "metadata_snapshot.hpp"
+#include "memory.hpp"
+
+using namespace netlm;
+
+void MetadataSnapshot::Deleter::operator()(uint8_t* data) const {
+	Memory::FreeCoTaskMem(data);
+}
+
+MetadataSnapshot::MetadataSnapshot(uint8_t* data, size_t size) : _data{data} {
+	if (!data || size < sizeof(MetadataHeader)) {
+		return;
+	}
+
+	const auto* header = reinterpret_cast<const MetadataHeader*>(data);
+	if (header->magic != MetadataMagic || header->version != MetadataVersion) {
+		return;
+	}
+
+	auto fits = [size](int32_t offset, int32_t count, size_t elementSize) {
+		return offset >= 0 && count >= 0 && static_cast<size_t>(offset) + static_cast<size_t>(count) * elementSize <= size;
+	};
+
+	if (!fits(header->typesOffset, header->typeCount, sizeof(TypeMetadata)) ||
+		!fits(header->methodsOffset, header->methodCount, sizeof(MethodMetadata)) ||
+		!fits(header->parametersOffset, header->parameterCount, sizeof(ManagedType)) ||
+		!fits(header->attributesOffset, header->attributeCount, sizeof(AttributeMetadata)) ||
+		!fits(header->stringsOffset, header->stringsSize, 1)) {
+		return;
+	}
+
+	_header = header;
+
+	auto types = GetTypes();
+	_typesByName.reserve(types.size());
+	for (const auto& type : types) {
+		_typesByName.try_emplace(std::string(GetString(type.name)), &type);
+	}
+}
+
+std::span<const TypeMetadata> MetadataSnapshot::GetTypes() const {
+	if (!_header) {
+		return {};
+	}
+	return GetSection<TypeMetadata>(_header->typesOffset, 0, _header->typeCount);
+}
+
+std::span<const MethodMetadata> MetadataSnapshot::GetMethods(const TypeMetadata& type) const {
+	return GetSection<MethodMetadata>(_header->methodsOffset, type.firstMethod, type.methodCount);
+}
+
+std::span<const ManagedType> MetadataSnapshot::GetParameters(const MethodMetadata& method) const {
+	return GetSection<ManagedType>(_header->parametersOffset, method.firstParameter, method.parameterCount);
+}
+
+std::span<const AttributeMetadata> MetadataSnapshot::GetAttributes(const TypeMetadata& type) const {
+	return GetSection<AttributeMetadata>(_header->attributesOffset, type.firstAttribute, type.attributeCount);
+}
+
+std::span<const AttributeMetadata> MetadataSnapshot::GetAttributes(const MethodMetadata& method) const {
+	return GetSection<AttributeMetadata>(_header->attributesOffset, method.firstAttribute, method.attributeCount);
+}
+
+std::string_view MetadataSnapshot::GetString(MetadataString string) const {
+	if (string.length <= 0) {
+		return {};
+	}
+	return { reinterpret_cast<const char*>(_data.get() + _header->stringsOffset + string.offset), static_cast<size_t>(string.length) };
+}
+
+const TypeMetadata* MetadataSnapshot::FindType(std::string_view typeName) const {
+	auto it = _typesByName.find(typeName);
+	return it != _typesByName.end() ? it->second : nullptr;
+}
+
+const MethodMetadata* MetadataSnapshot::FindMethod(const TypeMetadata& type, std::string_view methodName, bool* ambiguous) const {
+	const MethodMetadata* found = nullptr;
+	for (const auto& method : GetMethods(type)) {
+		if (GetString(method.name) != methodName) {
+			continue;
+		}
+		if (found) {
+			if (ambiguous) {
+				*ambiguous = true;
+			}
+			return nullptr;
+		}
+		found = &method;
+	}
+	return found;
+}
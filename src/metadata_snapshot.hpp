@@ -0,0 +1,92 @@
+#pragma once
+
+#include "core.hpp"
+#include "managed_type.hpp"
+#include "utils.hpp"
+
+namespace netlm {
+	// Layout shared with Plugify.TypeInterface (Metadata snapshot region), bump both versions together
+	constexpr uint32_t MetadataMagic = 0x4D474C50; // "PLGM"
+	constexpr uint32_t MetadataVersion = 2;
+
+	struct MetadataString {
+		int32_t offset;
+		int32_t length;
+	};
+
+	struct MetadataHeader {
+		uint32_t magic;
+		uint32_t version;
+		int32_t typeCount;
+		int32_t typesOffset;
+		int32_t methodCount;
+		int32_t methodsOffset;
+		int32_t parameterCount;
+		int32_t parametersOffset;
+		int32_t attributeCount;
+		int32_t attributesOffset;
+		int32_t stringsSize;
+		int32_t stringsOffset;
+	};
+
+	struct TypeMetadata {
+		ManagedHandle handle;
+		MetadataString name;
+		MetadataString baseName;
+		int32_t firstMethod;
+		int32_t methodCount;
+		int32_t firstAttribute;
+		int32_t attributeCount;
+	};
+
+	struct MethodMetadata {
+		ManagedHandle handle;
+		MetadataString name;
+		ManagedType returnType;
+		uint8_t accessibility; // TypeAccessibility
+		bool isStatic;
+		bool isAsync; // returns a task, returnType is the awaited result
+		int32_t firstParameter;
+		int32_t parameterCount;
+		int32_t firstAttribute;
+		int32_t attributeCount;
+	};
+
+	struct AttributeMetadata {
+		MetadataString typeName;
+	};
+
+	/// Read-only view over the flat metadata buffer produced by TypeInterface.GetAssemblyMetadata.
+	class MetadataSnapshot {
+	public:
+		MetadataSnapshot() = default;
+		MetadataSnapshot(uint8_t* data, size_t size);
+
+		std::span<const TypeMetadata> GetTypes() const;
+		std::span<const MethodMetadata> GetMethods(const TypeMetadata& type) const;
+		std::span<const ManagedType> GetParameters(const MethodMetadata& method) const;
+		std::span<const AttributeMetadata> GetAttributes(const TypeMetadata& type) const;
+		std::span<const AttributeMetadata> GetAttributes(const MethodMetadata& method) const;
+		std::string_view GetString(MetadataString string) const;
+
+		const TypeMetadata* FindType(std::string_view typeName) const;
+		// Null when no method has that name, or when several do (flagged through ambiguous, like Type.GetMethod)
+		const MethodMetadata* FindMethod(const TypeMetadata& type, std::string_view methodName, bool* ambiguous = nullptr) const;
+
+		explicit operator bool() const { return _header != nullptr; }
+
+	private:
+		template<typename T>
+		std::span<const T> GetSection(int32_t offset, int32_t first, int32_t count) const {
+			return { reinterpret_cast<const T*>(_data.get() + offset) + first, static_cast<size_t>(count) };
+		}
+
+		struct Deleter {
+			void operator()(uint8_t* data) const;
+		};
+
+		std::unique_ptr<uint8_t, Deleter> _data;
+		const MetadataHeader* _header{};
+		StringMap<const TypeMetadata*> _typesByName;
+	};
+}
@@ -17,6 +17,10 @@ void* MethodInfo::GetFunctionAddress() const {
 	return Managed.GetMethodInfoFunctionAddressFptr(_handle);
 }
 
+ExportThunk MethodInfo::GetExportThunk() const {
+	return Managed.GetExportThunkFptr(_handle);
+}
+
 Type& MethodInfo::GetReturnType() {
 	if (!_returnType) {
 		ManagedHandle handle{};
@@ -16,6 +16,7 @@ namespace netlm {
 
 		std::string GetName() const;
 		void* GetFunctionAddress() const;
+		ExportThunk GetExportThunk() const;
 
 		Type& GetReturnType();
 		const std::vector<Type*>& GetParameterTypes();
@@ -1,5 +1,6 @@
 #include "module.hpp"
 #include "attribute.hpp"
+#include "export_cache.hpp"
 #include "managed_assembly.hpp"
 #include "managed_functions.hpp"
 #include "memory.hpp"
@@ -13,6 +14,7 @@
 #include <plg/any.hpp>
 #include <plg/vector.hpp>
 
+#include <algorithm>
 #include <exception>
 #include <module_export.h>
 
@@ -40,12 +42,23 @@ Result<InitData> DotnetLanguageModule::Initialize(const Provider& provider, cons
 
 	_logger->Log(LOG_PREFIX "Inited!", Severity::Debug);
 
-	return InitData{{ .hasUpdate = false }};
+	// Batched plugin updates are driven from here
+	return InitData{{ .hasUpdate = true }};
 }
 
 Result<void> DotnetLanguageModule::Shutdown() {
+	auto typeCacheStats = TypeCache::Get().GetStats();
+	_logger->Log(std::format(LOG_PREFIX "Type cache: {} entries, {} hits, {} misses", typeCacheStats.size, typeCacheStats.hits, typeCacheStats.misses), Severity::Debug);
+
+	// Posted calls target the exports released below
+	_postedCalls.Drain(_postedCalls.GetCapacity(), [](const PostedCall&) {});
+
 	_scripts.clear();
 	_functions.clear();
+	_generatedExports.clear();
+	_internalCallTables.clear();
+	_pendingInternalCalls.clear();
+	_boundAssemblies.clear();
 
 	_loader.Unload();
 	_host.Shutdown();
@@ -59,10 +72,124 @@ Result<void> DotnetLanguageModule::Shutdown() {
 	return {};
 }
 
-Result<void> DotnetLanguageModule::OnUpdate([[maybe_unused]] std::chrono::milliseconds dt) {
+Result<void> DotnetLanguageModule::OnUpdate(std::chrono::milliseconds dt) {
+	DrainPostedCalls();
+	Managed.UpdatePluginsFptr(std::chrono::duration<float>(dt).count());
 	return {};
 }
 
+void DotnetLanguageModule::DrainPostedCalls() {
+	// Consecutive calls to the same export run as one batch, with a single managed transition. Every argument
+	// slot holds a plain value, so a row of the batch is the argument array of one call.
+	const HandleData* target = nullptr;
+	auto flush = [&] {
+		if (_postedRows.empty()) {
+			return;
+		}
+		std::array<const void*, kMaxPostedArgs> columns{};
+		std::array<uint32_t, kMaxPostedArgs> strides{};
+		for (size_t i = 0; i < target->plan.paramCount; ++i) {
+			columns[i] = &_postedRows.front()[i];
+			strides[i] = static_cast<uint32_t>(sizeof(_postedRows.front()));
+		}
+		Managed.InvokeExportBatchFptr(target->method, columns.data(), strides.data(), static_cast<int32_t>(target->plan.paramCount), static_cast<int32_t>(_postedRows.size()), nullptr, 0);
+		_postedRows.clear();
+	};
+
+	// At most one ring worth per frame, so producers posting while the batch runs can't stall the tick
+	_postedCalls.Drain(_postedCalls.GetCapacity(), [&](const PostedCall& call) {
+		const auto* data = static_cast<const HandleData*>(call.target);
+		if (data != target) {
+			flush();
+			target = data;
+		}
+		if (data->thunk) {
+			_postedRows.push_back(call.args);
+		} else {
+			// The reflection invoker has no batch path
+			auto args = call.args;
+			InternalCall(nullptr, const_cast<HandleData*>(data), args.data(), call.count, nullptr);
+		}
+	});
+	flush();
+
+	if (size_t dropped = _postedCalls.TakeDropped()) {
+		_logger->Log(std::format(LOG_PREFIX "{} posted calls dropped, the queue was full", dropped), Severity::Warning);
+	}
+}
+
+const HandleData* DotnetLanguageModule::FindExportData(void* function) {
+	for (const auto& [jitCallback, data] : _functions) {
+		if (static_cast<void*>(jitCallback.GetFunction()) == function) {
+			return data.get();
+		}
+	}
+
+	// A generated stub has no handle data, it goes through the regular export binding the first time it is needed
+	auto it = _generatedExports.find(function);
+	if (it == _generatedExports.end()) {
+		return nullptr;
+	}
+	auto& [method, assemblyId, binding] = it->second;
+	if (!binding) {
+		ManagedAssembly& assembly = _loader.FindAssembly(assemblyId);
+		Result<SharpMethodData> result = GenerateMethodExport(*method, assembly);
+		if (!result) {
+			_logger->Log(std::format(LOG_PREFIX "failed to bind '{}' for posted or batched calls: {}", method->GetFuncName(), result.error()), Severity::Warning);
+			_generatedExports.erase(it);
+			return nullptr;
+		}
+		binding = std::move(*result);
+	}
+	return binding->sharpFunction.get();
+}
+
+const HandleData* DotnetLanguageModule::FindPostTarget(void* function) {
+	const HandleData* data = FindExportData(function);
+	if (!data) {
+		return nullptr;
+	}
+	// Arguments are copied into the queue and the caller never sees a result, so only plain values qualify
+	const CallPlan& plan = data->plan;
+	bool postable = !plan.hasReturn && plan.paramCount <= kMaxPostedArgs
+		&& std::all_of(plan.byValue.begin(), plan.byValue.begin() + static_cast<ptrdiff_t>(plan.paramCount), [](bool byValue) { return byValue; });
+	return postable ? data : nullptr;
+}
+
+bool DotnetLanguageModule::Post(const HandleData* target, const uint64_t* args, size_t count) {
+	return target && count == target->plan.paramCount && _postedCalls.TryPush(target, args, count);
+}
+
+const HandleData* DotnetLanguageModule::FindBatchTarget(void* function) {
+	const HandleData* data = FindExportData(function);
+	return data && data->thunk && data->plan.batchable ? data : nullptr;
+}
+
+void DotnetLanguageModule::InvokeBatch(const HandleData* target, const void* const* columns, size_t count, void* results) const {
+	const CallPlan& plan = target->plan;
+	if (plan.hasReturn && !results) {
+		return;
+	}
+
+	auto* output = static_cast<uint8_t*>(results);
+	if (plan.constructReturn) {
+		for (size_t row = 0; row < count; ++row) {
+			plan.constructReturn(output + row * plan.returnStride);
+		}
+	}
+
+	// Row indices are 32-bit on the managed side
+	constexpr size_t kMaxRows = static_cast<size_t>(std::numeric_limits<int32_t>::max());
+	std::array<const void*, Signature::kMaxFuncArgs> chunk{};
+	for (size_t first = 0; first < count; first += kMaxRows) {
+		for (size_t i = 0; i < plan.paramCount; ++i) {
+			chunk[i] = static_cast<const uint8_t*>(columns[i]) + first * plan.strides[i];
+		}
+		auto rows = static_cast<int32_t>(std::min(count - first, kMaxRows));
+		Managed.InvokeExportBatchFptr(target->method, chunk.data(), plan.strides.data(), static_cast<int32_t>(plan.paramCount), rows, plan.hasReturn ? output + first * plan.returnStride : nullptr, static_cast<int32_t>(plan.returnStride));
+	}
+}
+
 Result<SharpMethodData> DotnetLanguageModule::GenerateMethodExport(const Method& method, ManagedAssembly& assembly) {
 	auto separated = Utils::Split(method.GetFuncName(), ".");
 	size_t size = separated.size();
@@ -71,41 +198,90 @@ Result<SharpMethodData> DotnetLanguageModule::GenerateMethodExport(const Method&
 		return MakeError("invalid function format: '{}'. Provide name in that format: 'Namespace.Class.Method' or 'Namespace.MyParentClass+MyNestedClass.Method' or 'Class.Method'", method.GetFuncName());
 	}
 
+	// Signature validation runs on the metadata snapshot, without a managed call per type
+	const MetadataSnapshot& metadata = assembly.GetMetadataSnapshot();
+	if (!metadata) {
+		return MakeError("failed to read assembly metadata");
+	}
+
 	std::string_view className = noNamespace ? separated[size-2] : std::string_view(separated[0].data(), separated[size-1].data() - 1);
-	Type& type = assembly.GetType(className);
+	const TypeMetadata* type = metadata.FindType(className);
 	if (!type) {
 		return MakeError("failed to find class '{}'", className);
 	}
 
 	std::string_view methodName = separated[size-1];
-	MethodInfo methodInfo = type.GetMethod(methodName);
-	if (!methodInfo) {
-		return MakeError("failed to find method '{}'", methodName);
+	bool ambiguous = false;
+	const MethodMetadata* methodData = metadata.FindMethod(*type, methodName, &ambiguous);
+	if (ambiguous) {
+		return MakeError("ambiguous method '{}', it has several overloads", methodName);
 	}
-
-	ValueType returnType = methodInfo.GetReturnType().GetManagedType().type;
-	ValueType methodReturnType = method.GetRetType().GetType();
-	if (returnType != methodReturnType) {
-		return MakeError("invalid return type '{}' when it should have '{}'", plg::enum_to_string(methodReturnType), plg::enum_to_string(returnType));
+	if (!methodData) {
+		return MakeError("failed to find method '{}'", methodName);
 	}
 
-	const auto& parameterTypes = methodInfo.GetParameterTypes();
+	auto parameterTypes = metadata.GetParameters(*methodData);
 
 	size_t paramCount = parameterTypes.size();
 	const std::inplace_vector<Property, Signature::kMaxFuncArgs>& paramTypes = method.GetParamTypes();
-	if (paramCount != paramTypes.size()) {
-		return MakeError("invalid parameter count {} when it should have {}", paramTypes.size(), paramCount);
+
+	ValueType returnType = methodData->returnType.type;
+	ValueType methodReturnType = method.GetRetType().GetType();
+	if (methodData->isAsync) {
+		// Task returning methods hand the awaited result to a completion callback, passed after their parameters
+		if (methodReturnType != ValueType::Void) {
+			return MakeError("invalid return type '{}' of async method, it should be 'Void'", plg::enum_to_string(methodReturnType));
+		}
+		if (paramCount + 1 != paramTypes.size()) {
+			return MakeError("invalid parameter count {} of async method when it should have {} (with completion callback)", paramTypes.size(), paramCount + 1);
+		}
+		const Property& completion = paramTypes.back();
+		if (completion.GetType() != ValueType::Function || completion.IsRef()) {
+			return MakeError("invalid completion callback type '{}', it should be 'Function'", plg::enum_to_string(completion.GetType()));
+		}
+		if (const auto& prototype = completion.GetPrototype()) {
+			const auto& resultTypes = prototype->GetParamTypes();
+			size_t resultCount = returnType == ValueType::Void ? 0 : 1;
+			if (prototype->GetRetType().GetType() != ValueType::Void || resultTypes.size() != resultCount || (resultCount && resultTypes[0].GetType() != returnType)) {
+				return MakeError("invalid completion callback prototype, it should take '{}' and return 'Void'", plg::enum_to_string(returnType));
+			}
+		}
+	} else {
+		if (returnType != methodReturnType) {
+			return MakeError("invalid return type '{}' when it should have '{}'", plg::enum_to_string(methodReturnType), plg::enum_to_string(returnType));
+		}
+		if (paramCount != paramTypes.size()) {
+			return MakeError("invalid parameter count {} when it should have {}", paramTypes.size(), paramCount);
+		}
 	}
 
 	for (size_t i = 0; i < paramCount; ++i) {
-		ValueType paramType = parameterTypes[i]->GetManagedType().type;
+		ValueType paramType = parameterTypes[i].type;
 		ValueType methodParamType = paramTypes[i].GetType();
 		if (paramType != methodParamType) {
 			return MakeError("invalid param type '{}' at index {} when it should have '{}'", plg::enum_to_string(methodParamType), i, plg::enum_to_string(paramType));
 		}
+		if (parameterTypes[i].ref && !paramTypes[i].IsRef()) {
+			return MakeError("param at index {} should be passed by reference", i);
+		}
 	}
 
-	auto data = std::make_unique<HandleData>(type.GetHandle(), methodInfo.GetHandle());
+	auto result = BindMethodExport(method, type->handle, methodData->handle);
+	if (result && methodData->isAsync && !result->sharpFunction->thunk) {
+		// Only the thunk knows where the completion callback is, the reflection invoker can't call these
+		return MakeError("unsupported parameter or result types of async method '{}'", methodName);
+	}
+	return result;
+}
+
+Result<SharpMethodData> DotnetLanguageModule::BindMethodExport(const Method& method, ManagedHandle typeHandle, ManagedHandle methodHandle) {
+	auto plan = CompileCallPlan(method);
+	if (!plan) {
+		return MakeError("unsupported parameter types in '{}'", method.GetName());
+	}
+
+	MethodInfo methodInfo(methodHandle);
+	auto data = std::make_unique<HandleData>(typeHandle, methodInfo.GetHandle(), methodInfo.GetExportThunk(), *plan);
 
 	JitCallback callback{};
 	Address methodAddr = callback.GetJitFunc(method, &InternalCall, data.get());
@@ -125,20 +301,116 @@ Result<LoadData> DotnetLanguageModule::OnPluginLoad(const Extension& plugin) {
 		return MakeError(_loader.GetError());
 	}
 
-	Type& pluginClassType = assembly.GetTypeByBaseType("Plugify.Plugin");
-	if (!pluginClassType) {
-		return MakeError("Failed to find 'Plugify.Plugin' class implementation");
+	// A plugin that fails to load unloads its assembly right away, with the exports and types cached for it
+	auto unload = [this, firstFunction = _functions.size(), assemblyId = assembly.GetID()] {
+		_functions.erase(_functions.begin() + static_cast<ptrdiff_t>(firstFunction), _functions.end());
+		std::erase_if(_generatedExports, [&](const auto& entry) { return entry.second.assembly == assemblyId; });
+		ForgetInternalCalls(assemblyId);
+		_loader.UnloadAssembly(assemblyId);
+	};
+
+	const std::vector<Method>& exportedMethods = plugin.GetMethods();
+
+	// Stubs generated by Plugify.Generators already have the native signature
+	std::vector<std::string_view> funcNames;
+	std::vector<uint64_t> signatures;
+	funcNames.reserve(exportedMethods.size());
+	signatures.reserve(exportedMethods.size());
+	for (const auto& method : exportedMethods) {
+		funcNames.emplace_back(method.GetFuncName());
+		signatures.emplace_back(ExportCache::HashSignature(method));
+	}
+	std::vector<uint64_t> stubSignatures;
+	std::vector<void*> generatedExports = assembly.GetExports(funcNames, stubSignatures);
+
+	// A stale or hand-edited manifest no longer matches its stub, such an export goes through full validation instead
+	for (size_t i = 0; i < exportedMethods.size(); ++i) {
+		if (generatedExports[i] && stubSignatures[i] != signatures[i]) {
+			_logger->Log(std::format(LOG_PREFIX "{}: generated stub of '{}' does not match the manifest signature", plugin.GetName(), funcNames[i]), Severity::Warning);
+			generatedExports[i] = nullptr;
+		}
+	}
+
+	// Bindings saved by a previous start of the same assembly skip the reflection lookups and signature validation
+	std::filesystem::path cachePath = _provider->GetCacheDir() / "dotnet" / std::format("{}.exports", plugin.GetName());
+	ManagedGuid mvid = assembly.GetModuleVersionId();
+	FileStamp stamp = FileStamp::Of(assemblyPath);
+	ExportCache cache(mvid, stamp);
+	bool cached = cache.Load(cachePath);
+
+	// Plugin class and lifecycle tokens come first, then a type/method pair per cached export (slot 0 means not cached)
+	std::vector<int32_t> tokens;
+	std::vector<ManagedHandle> handles;
+	std::vector<size_t> cachedSlots(exportedMethods.size());
+	if (cached) {
+		const PluginBinding& binding = cache.GetPluginBinding();
+		tokens = { binding.typeToken, binding.update.token, binding.start.token, binding.end.token };
+		for (size_t i = 0; i < exportedMethods.size(); ++i) {
+			if (generatedExports[i]) {
+				continue;
+			}
+			if (const ExportBinding* exportBinding = cache.FindExport(funcNames[i], signatures[i])) {
+				cachedSlots[i] = tokens.size();
+				tokens.emplace_back(exportBinding->typeToken);
+				tokens.emplace_back(exportBinding->methodToken);
+			}
+		}
+
+		cached = assembly.ResolveMetadataTokens(tokens, handles) && handles[0];
+		if (!cached) {
+			std::ranges::fill(cachedSlots, 0);
+		}
+	}
+
+	Type* pluginClassType;
+	if (cached) {
+		pluginClassType = TypeCache::Get().Add(handles[0]);
+	} else {
+		pluginClassType = &assembly.GetTypeByBaseType("Plugify.Plugin");
+		if (!*pluginClassType) {
+			unload();
+			return MakeError("Failed to find 'Plugify.Plugin' class implementation");
+		}
+	}
+
+	const PluginBinding& cachedBinding = cache.GetPluginBinding();
+	ScriptMethod update = cached ? ScriptMethod(handles[1], cachedBinding.update.error) : ScriptMethod(*pluginClassType, "OnPluginUpdate");
+	ScriptMethod start = cached ? ScriptMethod(handles[2], cachedBinding.start.error) : ScriptMethod(*pluginClassType, "OnPluginStart");
+	ScriptMethod end = cached ? ScriptMethod(handles[3], cachedBinding.end.error) : ScriptMethod(*pluginClassType, "OnPluginEnd");
+
+	ExportCache updatedCache(mvid, stamp);
+	bool cacheable = true;
+	bool dirty = !cached;
+
+	if (cached) {
+		updatedCache.SetPluginBinding(cachedBinding);
+	} else {
+		// Members inherited from another assembly have no token here, such a plugin is not cached
+		auto bindLifecycle = [&](const ScriptMethod& scriptMethod) {
+			LifecycleBinding lifecycle{ scriptMethod.method ? assembly.GetMetadataToken(scriptMethod.method) : 0, scriptMethod.error };
+			cacheable &= !scriptMethod.method || lifecycle.token != 0;
+			return lifecycle;
+		};
+		PluginBinding binding{ assembly.GetMetadataToken(*pluginClassType), bindLifecycle(update), bindLifecycle(start), bindLifecycle(end) };
+		cacheable &= binding.typeToken != 0;
+		updatedCache.SetPluginBinding(binding);
 	}
 
 	std::vector<std::string> exportErrors;
 
-	const std::vector<Method>& exportedMethods = plugin.GetMethods();
 	std::vector<MethodData> methods;
 	methods.reserve(exportedMethods.size());
 
 	for (size_t i = 0; i < exportedMethods.size(); ++i) {
 		const auto& method = exportedMethods[i];
-		Result<SharpMethodData> generateResult = GenerateMethodExport(method, assembly);
+		if (void* addr = generatedExports[i]) {
+			methods.emplace_back(method, addr);
+			_generatedExports.try_emplace(addr, &method, assembly.GetID());
+			continue;
+		}
+
+		size_t slot = cachedSlots[i];
+		Result<SharpMethodData> generateResult = slot ? BindMethodExport(method, handles[slot], handles[slot + 1]) : GenerateMethodExport(method, assembly);
 		if (!generateResult) {
 			exportErrors.emplace_back(std::format("{:>3}. {} {}", i + 1, method.GetName(), generateResult.error()));
 			if (constexpr size_t kMaxDisplay = 100; exportErrors.size() >= kMaxDisplay) {
@@ -147,29 +419,51 @@ Result<LoadData> DotnetLanguageModule::OnPluginLoad(const Extension& plugin) {
 			}
 			continue;
 		}
+
+		if (slot) {
+			updatedCache.AddExport(funcNames[i], { signatures[i], tokens[slot], tokens[slot + 1] });
+		} else {
+			const HandleData& handle = *generateResult->sharpFunction;
+			if (int32_t methodToken = assembly.GetMetadataToken(MethodInfo(handle.method))) {
+				updatedCache.AddExport(funcNames[i], { signatures[i], assembly.GetMetadataToken(Type(handle.type)), methodToken });
+				dirty = true;
+			}
+		}
+
 		methods.emplace_back(method, generateResult->jitCallback.GetFunction());
 		_functions.emplace_back(std::move(*generateResult));
 	}
 
 	if (!exportErrors.empty()) {
+		unload();
 		return MakeError("Invalid methods:\n{}", plg::join(exportErrors, "\n"));
 	}
 
-	const auto [it, result] = _scripts.try_emplace(plugin.GetId(), plugin, assembly.GetID(), pluginClassType);
+	const auto [it, result] = _scripts.try_emplace(plugin.GetId(), plugin, assembly.GetID(), *pluginClassType, update, start, end);
 	if (!result) {
+		unload();
 		return MakeError("Save plugin data to map unsuccessful");
 	}
 
+	if (dirty && cacheable && !updatedCache.Save(cachePath)) {
+		_logger->Log(std::format(LOG_PREFIX "{}: failed to write export cache '{}'", plugin.GetName(), cachePath.string()), Severity::Warning);
+	}
+
+	// Start and end always come through the module, they wire internal calls and toggle batched updates
 	const auto& [_, script] = *it;
-	return LoadData{ std::move(methods), &script, { script.HasUpdate(), script.HasStart(), script.HasEnd(), !exportedMethods.empty() } };
+	return LoadData{ std::move(methods), &script, { script.HasUpdate() && !script.IsUpdateBatched(), true, script.HasEnd() || script.IsUpdateBatched(), !exportedMethods.empty() } };
 }
 
 Result<void> DotnetLanguageModule::OnPluginStart(const Extension& plugin) {
-	auto result = plugin.GetUserData().As<ScriptInstance*>()->InvokeOnStart();
+	FlushInternalCalls();
+
+	auto* script = plugin.GetUserData().As<ScriptInstance*>();
+	auto result = script->InvokeOnStart();
 	if (!result.empty()) {
 		_logger->Log(std::format(LOG_PREFIX "{}: call of 'OnPluginStart' failed\n{}", plugin.GetName(), result), Severity::Error);
 		return MakeError(std::string(result));
 	}
+	script->SetUpdateEnabled(true);
 	return {};
 }
 
@@ -183,7 +477,9 @@ Result<void> DotnetLanguageModule::OnPluginUpdate(const Extension& plugin, std::
 }
 
 Result<void> DotnetLanguageModule::OnPluginEnd(const Extension& plugin) {
-	auto result = plugin.GetUserData().As<ScriptInstance*>()->InvokeOnEnd();
+	auto* script = plugin.GetUserData().As<ScriptInstance*>();
+	script->SetUpdateEnabled(false);
+	auto result = script->InvokeOnEnd();
 	if (!result.empty()) {
 		_logger->Log(std::format(LOG_PREFIX "{}: call of 'OnPluginEnd' failed\n{}", plugin.GetName(), result), Severity::Error);
 		return MakeError(std::string(result));
@@ -198,14 +494,18 @@ bool DotnetLanguageModule::IsDebugBuild() const noexcept {
 Result<void> DotnetLanguageModule::OnMethodExport(const Extension& plugin) {
 	auto className = std::format("{}.{}", plugin.GetName(), plugin.GetName());
 
+	// Only collected here, FlushInternalCalls hands the whole load wave to the assemblies at once
+	InternalCallTable table{};
+
 	if (auto* script = FindScript(plugin.GetId())) {
 		auto& assemblyId = script->GetAssemblyId();
 		// Add as C# calls (direct)
 		auto& ownerAssembly = _loader.FindAssembly(assemblyId);
 		assert(ownerAssembly);
 
+		table.owner = assemblyId;
+
 		for (const auto& [method, _] : plugin.GetMethodsData()) {
-			auto variableName = std::format("_{}", method.GetName());
 			auto separated= Utils::Split(method.GetFuncName(), ".");
 			size_t size = separated.size();
 
@@ -216,33 +516,64 @@ Result<void> DotnetLanguageModule::OnMethodExport(const Extension& plugin) {
 			MethodInfo methodInfo = type.GetMethod(separated[size-1]);
 			assert(methodInfo);
 
-			void* addr = methodInfo.GetFunctionAddress();
-
-			for (auto& assembly : _loader.GetLoadedAssemblies()) {
-				// No self export
-				if (assembly.GetID() == assemblyId)
-					continue;
-
-				assembly.AddInternalCall(className, variableName, addr);
-			}
+			table.calls.emplace_back(std::format("_{}", method.GetName()), methodInfo.GetFunctionAddress());
 		}
 	} else {
 		// Add as C++ calls
 		for (const auto& [method, addr] : plugin.GetMethodsData()) {
-			auto variableName = std::format("__{}", method.GetName());
-			for (auto& assembly : _loader.GetLoadedAssemblies()) {
-				assembly.AddInternalCall(className, variableName, addr);
-			}
+			table.calls.emplace_back(std::format("__{}", method.GetName()), addr);
 		}
 	}
 
+	_internalCallTables.insert_or_assign(className, std::move(table));
+	_pendingInternalCalls.emplace_back(std::move(className));
+
+	return {};
+}
+
+void DotnetLanguageModule::FlushInternalCalls() {
+	// Counting would miss an assembly loaded in place of an unloaded one that is still in the bound set
+	bool allBound = std::ranges::all_of(_loader.GetLoadedAssemblies(), [this](const ManagedAssembly& assembly) {
+		return _boundAssemblies.contains(assembly.GetID());
+	});
+	if (_pendingInternalCalls.empty() && allBound) {
+		return;
+	}
+
 	constexpr bool warnOnMissing = NETLM_IS_DEBUG;
 
 	for (auto& assembly : _loader.GetLoadedAssemblies()) {
+		auto bind = [&assembly](const std::string& className, const InternalCallTable& table) {
+			// No self export, and only assemblies that declare the binding class get its calls
+			if (table.owner == assembly.GetID() || !assembly.GetType(className)) {
+				return;
+			}
+			for (const auto& [variableName, addr] : table.calls) {
+				assembly.AddInternalCall(className, variableName, addr);
+			}
+		};
+
+		// An assembly bound for the first time gets every export so far, the others only what changed since
+		if (_boundAssemblies.insert(assembly.GetID()).second) {
+			for (const auto& [className, table] : _internalCallTables) {
+				bind(className, table);
+			}
+		} else {
+			for (const auto& className : _pendingInternalCalls) {
+				bind(className, _internalCallTables.find(className)->second);
+			}
+		}
+
 		assembly.UploadInternalCalls(warnOnMissing);
 	}
 
-	return {};
+	_pendingInternalCalls.clear();
+}
+
+void DotnetLanguageModule::ForgetInternalCalls(ManagedGuid assemblyId) {
+	_boundAssemblies.erase(assemblyId);
+	std::erase_if(_internalCallTables, [&](const auto& entry) { return entry.second.owner == assemblyId; });
+	std::erase_if(_pendingInternalCalls, [this](const std::string& className) { return !_internalCallTables.contains(className); });
 }
 
 const ScriptInstance* DotnetLanguageModule::FindScript(UniqueId pluginId) const {
@@ -266,150 +597,169 @@ std::shared_ptr<Method> DotnetLanguageModule::FindMethod(std::string_view name)
 	return {};
 }
 
-template<typename TFunc>
-static void ManagedCall(const Method& method, Address data, uint64_t* p, size_t count, void* r, TFunc&& func) {
-	ValueType retType = method.GetRetType().GetType();
-	const std::inplace_vector<Property, Signature::kMaxFuncArgs>& paramProps = method.GetParamTypes();
+template<typename T>
+static void ConstructReturn(void* r) {
+	ReturnSlot(r, sizeof(T)).Construct<T>();
+}
 
-	ParametersSpan params(p, count);
-	ReturnSlot ret(r, ValueUtils::SizeOf(retType));
-	
-	ArgumentList args;
-	args.reserve(count);
+std::optional<CallPlan> DotnetLanguageModule::CompileCallPlan(const Method& method) {
+	CallPlan plan;
+	plan.batchable = true;
 
-	for (size_t i = 0; i < count; ++i) {
+	const std::inplace_vector<Property, Signature::kMaxFuncArgs>& paramProps = method.GetParamTypes();
+	for (size_t i = 0; i < paramProps.size(); ++i) {
 		const auto& param = paramProps[i];
+		plan.strides[i] = static_cast<uint32_t>(ValueUtils::SizeOf(param.GetType()));
 		if (param.IsRef()) {
-			args.emplace_back(params.Get<void*>(i));
-		} else {
-			switch (param.GetType()) {
-				// Value types
-				case ValueType::Bool:
-				case ValueType::Char8:
-				case ValueType::Char16:
-				case ValueType::Int8:
-				case ValueType::Int16:
-				case ValueType::Int32:
-				case ValueType::Int64:
-				case ValueType::UInt8:
-				case ValueType::UInt16:
-				case ValueType::UInt32:
-				case ValueType::UInt64:
-				case ValueType::Pointer:
-				case ValueType::Float:
-				case ValueType::Double:
-					args.emplace_back(&p[i]);
-					break;
-				// Ref types
-				case ValueType::Function:
-				case ValueType::Vector2:
-				case ValueType::Vector3:
-				case ValueType::Vector4:
-				case ValueType::Matrix4x4:
-				case ValueType::String:
-				case ValueType::Any:
-				case ValueType::ArrayBool:
-				case ValueType::ArrayChar8:
-				case ValueType::ArrayChar16:
-				case ValueType::ArrayInt8:
-				case ValueType::ArrayInt16:
-				case ValueType::ArrayInt32:
-				case ValueType::ArrayInt64:
-				case ValueType::ArrayUInt8:
-				case ValueType::ArrayUInt16:
-				case ValueType::ArrayUInt32:
-				case ValueType::ArrayUInt64:
-				case ValueType::ArrayPointer:
-				case ValueType::ArrayFloat:
-				case ValueType::ArrayDouble:
-				case ValueType::ArrayString:
-				case ValueType::ArrayAny:
-				case ValueType::ArrayVector2:
-				case ValueType::ArrayVector3:
-				case ValueType::ArrayVector4:
-				case ValueType::ArrayMatrix4x4:
-					args.emplace_back(params.Get<void*>(i));
-					break;
-				default:
-					std::puts(LOG_PREFIX "Unsupported types!\n");
-					std::terminate();
-					break;
-			}
+			continue;
+		}
+		switch (param.GetType()) {
+			// Value types
+			case ValueType::Bool:
+			case ValueType::Char8:
+			case ValueType::Char16:
+			case ValueType::Int8:
+			case ValueType::Int16:
+			case ValueType::Int32:
+			case ValueType::Int64:
+			case ValueType::UInt8:
+			case ValueType::UInt16:
+			case ValueType::UInt32:
+			case ValueType::UInt64:
+			case ValueType::Pointer:
+			case ValueType::Float:
+			case ValueType::Double:
+				plan.byValue[i] = true;
+				break;
+			// Ref types
+			case ValueType::Function:
+				plan.batchable = false;
+				break;
+			case ValueType::Vector2:
+			case ValueType::Vector3:
+			case ValueType::Vector4:
+			case ValueType::Matrix4x4:
+			case ValueType::String:
+			case ValueType::Any:
+			case ValueType::ArrayBool:
+			case ValueType::ArrayChar8:
+			case ValueType::ArrayChar16:
+			case ValueType::ArrayInt8:
+			case ValueType::ArrayInt16:
+			case ValueType::ArrayInt32:
+			case ValueType::ArrayInt64:
+			case ValueType::ArrayUInt8:
+			case ValueType::ArrayUInt16:
+			case ValueType::ArrayUInt32:
+			case ValueType::ArrayUInt64:
+			case ValueType::ArrayPointer:
+			case ValueType::ArrayFloat:
+			case ValueType::ArrayDouble:
+			case ValueType::ArrayString:
+			case ValueType::ArrayAny:
+			case ValueType::ArrayVector2:
+			case ValueType::ArrayVector3:
+			case ValueType::ArrayVector4:
+			case ValueType::ArrayMatrix4x4:
+				break;
+			default:
+				return std::nullopt;
 		}
 	}
 
+	ValueType retType = method.GetRetType().GetType();
+	plan.hasReturn = retType != ValueType::Void;
+	plan.paramCount = paramProps.size();
+	plan.returnStride = static_cast<uint32_t>(ValueUtils::SizeOf(retType));
+
 	switch (retType) {
 		case ValueType::String:
-			ret.Construct<plg::string>();
+			plan.constructReturn = &ConstructReturn<plg::string>;
 			break;
 		case ValueType::Any:
-			ret.Construct<plg::any>();
+			plan.constructReturn = &ConstructReturn<plg::any>;
 			break;
 		case ValueType::ArrayBool:
-			ret.Construct<plg::vector<bool>>();
+			plan.constructReturn = &ConstructReturn<plg::vector<bool>>;
 			break;
 		case ValueType::ArrayChar8:
-			ret.Construct<plg::vector<char>>();
+			plan.constructReturn = &ConstructReturn<plg::vector<char>>;
 			break;
 		case ValueType::ArrayChar16:
-			ret.Construct<plg::vector<char16_t>>();
+			plan.constructReturn = &ConstructReturn<plg::vector<char16_t>>;
 			break;
 		case ValueType::ArrayInt8:
-			ret.Construct<plg::vector<int8_t>>();
+			plan.constructReturn = &ConstructReturn<plg::vector<int8_t>>;
 			break;
 		case ValueType::ArrayInt16:
-			ret.Construct<plg::vector<int16_t>>();
+			plan.constructReturn = &ConstructReturn<plg::vector<int16_t>>;
 			break;
 		case ValueType::ArrayInt32:
-			ret.Construct<plg::vector<int32_t>>();
+			plan.constructReturn = &ConstructReturn<plg::vector<int32_t>>;
 			break;
 		case ValueType::ArrayInt64:
-			ret.Construct<plg::vector<int64_t>>();
+			plan.constructReturn = &ConstructReturn<plg::vector<int64_t>>;
 			break;
 		case ValueType::ArrayUInt8:
-			ret.Construct<plg::vector<uint8_t>>();
+			plan.constructReturn = &ConstructReturn<plg::vector<uint8_t>>;
 			break;
 		case ValueType::ArrayUInt16:
-			ret.Construct<plg::vector<uint16_t>>();
+			plan.constructReturn = &ConstructReturn<plg::vector<uint16_t>>;
 			break;
 		case ValueType::ArrayUInt32:
-			ret.Construct<plg::vector<uint32_t>>();
+			plan.constructReturn = &ConstructReturn<plg::vector<uint32_t>>;
 			break;
 		case ValueType::ArrayUInt64:
-			ret.Construct<plg::vector<uint64_t>>();
+			plan.constructReturn = &ConstructReturn<plg::vector<uint64_t>>;
 			break;
 		case ValueType::ArrayPointer:
-			ret.Construct<plg::vector<uintptr_t>>();
+			plan.constructReturn = &ConstructReturn<plg::vector<uintptr_t>>;
 			break;
 		case ValueType::ArrayFloat:
-			ret.Construct<plg::vector<float>>();
+			plan.constructReturn = &ConstructReturn<plg::vector<float>>;
 			break;
 		case ValueType::ArrayDouble:
-			ret.Construct<plg::vector<double>>();
+			plan.constructReturn = &ConstructReturn<plg::vector<double>>;
 			break;
 		case ValueType::ArrayString:
-			ret.Construct<plg::vector<plg::string>>();
+			plan.constructReturn = &ConstructReturn<plg::vector<plg::string>>;
 			break;
 		case ValueType::ArrayAny:
-			ret.Construct<plg::vector<plg::any>>();
+			plan.constructReturn = &ConstructReturn<plg::vector<plg::any>>;
 			break;
 		case ValueType::ArrayVector2:
-			ret.Construct<plg::vector<plg::vec2>>();
+			plan.constructReturn = &ConstructReturn<plg::vector<plg::vec2>>;
 			break;
 		case ValueType::ArrayVector3:
-			ret.Construct<plg::vector<plg::vec3>>();
+			plan.constructReturn = &ConstructReturn<plg::vector<plg::vec3>>;
 			break;
 		case ValueType::ArrayVector4:
-			ret.Construct<plg::vector<plg::vec4>>();
+			plan.constructReturn = &ConstructReturn<plg::vector<plg::vec4>>;
 			break;
 		case ValueType::ArrayMatrix4x4:
-			ret.Construct<plg::vector<plg::mat4x4>>();
+			plan.constructReturn = &ConstructReturn<plg::vector<plg::mat4x4>>;
 			break;
 		default:
 			break;
 	}
 
-	if (retType != ValueType::Void) {
+	return plan;
+}
+
+template<typename TFunc>
+static void ManagedCall(const CallPlan& plan, Address data, uint64_t* p, size_t count, void* r, TFunc&& func) {
+	ParametersSpan params(p, count);
+
+	ArgumentList args(count);
+	for (size_t i = 0; i < count; ++i) {
+		args[i] = plan.byValue[i] ? &p[i] : params.Get<void*>(i);
+	}
+
+	if (plan.constructReturn) {
+		plan.constructReturn(r);
+	}
+
+	if (plan.hasReturn) {
 		func(data, args, r);
 	} else {
 		func(data, args, std::nullopt);
@@ -417,22 +767,28 @@ static void ManagedCall(const Method& method, Address data, uint64_t* p, size_t
 }
 
 // C++ to C#
-void DotnetLanguageModule::InternalCall(const Method* method, Address data, uint64_t* p, size_t count, void* ret) {
-	ManagedCall(*method, data, p, count, ret, [](Address dt, ArgumentList& args, std::optional<void*> retPtr) {
-		const auto& [typeHandle, methodHandle] = *dt.As<HandleData*>();
-		Type type(typeHandle);
+void DotnetLanguageModule::InternalCall([[maybe_unused]] const Method* method, Address data, uint64_t* p, size_t count, void* ret) {
+	const auto& handleData = *data.As<HandleData*>();
+	ManagedCall(handleData.plan, data, p, count, ret, [](Address dt, ArgumentList& args, std::optional<void*> retPtr) {
+		const auto& handle = *dt.As<HandleData*>();
+		if (handle.thunk) {
+			handle.thunk(args.data(), retPtr.value_or(nullptr));
+			return;
+		}
+		Type type(handle.type);
 		if (retPtr.has_value()) {
-			type.InvokeStaticMethodRetInternal(methodHandle, args.data(), args.size(), *retPtr);
+			type.InvokeStaticMethodRetInternal(handle.method, args.data(), args.size(), *retPtr);
 		} else {
-			type.InvokeStaticMethodInternal(methodHandle, args.data(), args.size());
+			type.InvokeStaticMethodInternal(handle.method, args.data(), args.size());
 		}
 	});
 }
 
 // C++ to C#
-void DotnetLanguageModule::DelegateCall(const Method* method, Address data, uint64_t* p, size_t count, void* ret) {
-	ManagedCall(*method, data, p, count, ret, [](Address dt, ArgumentList& args, std::optional<void*> retPtr) {
-		auto delegateHandle = dt.As<ManagedHandle>();
+void DotnetLanguageModule::DelegateCall([[maybe_unused]] const Method* method, Address data, uint64_t* p, size_t count, void* ret) {
+	const auto& callbackData = *data.As<DelegateCallback*>();
+	ManagedCall(callbackData.plan, data, p, count, ret, [](Address dt, ArgumentList& args, std::optional<void*> retPtr) {
+		auto delegateHandle = dt.As<DelegateCallback*>()->delegate;
 		if (retPtr.has_value()) {
 			ManagedObject::InvokeDelegateRetInternal(delegateHandle, args.data(), args.size(), *retPtr);
 		} else {
@@ -472,18 +828,18 @@ void DotnetLanguageModule::MessageCallback(std::string_view message, MessageLeve
 
 /*_________________________________________________*/
 
-ScriptMethod::ScriptMethod(ManagedObject instance, std::string_view methodName)
-	: method{instance.GetType().GetMethod(methodName)}
+ScriptMethod::ScriptMethod(Type& type, std::string_view methodName)
+	: method{type.GetMethod(methodName)}
 	, error{method ? method.GetReturnType().GetFullName() == "System.String" : false}
 {}
 
-ScriptInstance::ScriptInstance(const Extension& plugin, ManagedGuid assembly, Type& type)
+ScriptInstance::ScriptInstance(const Extension& plugin, ManagedGuid assembly, Type& type, ScriptMethod update, ScriptMethod start, ScriptMethod end)
 	: _plugin{plugin}
 	, _assembly{assembly}
 	, _instance{type.CreateInstance()}
-	, _update{_instance, "OnPluginUpdate"}
-	, _start{_instance, "OnPluginStart"}
-	, _end{_instance, "OnPluginEnd"}
+	, _update{update}
+	, _start{start}
+	, _end{end}
 {
 	const std::vector<Dependency>& dependencies = plugin.GetDependencies();
 
@@ -512,13 +868,25 @@ ScriptInstance::ScriptInstance(const Extension& plugin, ManagedGuid assembly, Ty
 	_instance.SetPropertyValue("DataDir", plg::string(plg::as_string(provider->GetDataDir())));
 	_instance.SetPropertyValue("LogsDir", plg::string(plg::as_string(provider->GetLogsDir())));
 	_instance.SetPropertyValue("CacheDir", plg::string(plg::as_string(provider->GetCacheDir())));
+
+	if (_update.method) {
+		auto name = String::New(plugin.GetName());
+		_batchedUpdate = Managed.RegisterUpdateFptr(_instance.GetHandle(), _update.method.GetHandle(), name);
+		String::Free(name);
+	}
 }
 
 ScriptInstance::~ScriptInstance() {
+	if (_batchedUpdate) {
+		Managed.UnregisterUpdateFptr(_instance.GetHandle());
+	}
 	_instance.Destroy();
 };
 
 ScriptResult ScriptInstance::InvokeOnStart() const {
+	if (!_start.method) {
+		return {};
+	}
 	if (_start.error) {
 		return _instance.InvokeMethodRaw<plg::string>(_start.method);
 	}
@@ -535,6 +903,9 @@ ScriptResult ScriptInstance::InvokeOnUpdate(float dt) const {
 }
 
 ScriptResult ScriptInstance::InvokeOnEnd() const {
+	if (!_end.method) {
+		return {};
+	}
 	if (_end.error) {
 		return _instance.InvokeMethodRaw<plg::string>(_end.method);
 	}
@@ -554,6 +925,12 @@ bool ScriptInstance::HasEnd() const {
 	return static_cast<bool>(_end.method);
 }
 
+void ScriptInstance::SetUpdateEnabled(bool enabled) const {
+	if (_batchedUpdate) {
+		Managed.SetUpdateEnabledFptr(_instance.GetHandle(), enabled);
+	}
+}
+
 namespace netlm {
 	DotnetLanguageModule g_netlm;
 }
@@ -598,6 +975,24 @@ extern "C" {
 		return g_netlm.GetProfiler() != nullptr;
 	}
 
+	NETLM_EXPORT const void* GetPostTarget(void* function) {
+		return g_netlm.FindPostTarget(function);
+	}
+
+	NETLM_EXPORT bool PostCall(const void* target, const uint64_t* args, size_t count) {
+		return g_netlm.Post(static_cast<const HandleData*>(target), args, count);
+	}
+
+	NETLM_EXPORT const void* GetBatchTarget(void* function) {
+		return g_netlm.FindBatchTarget(function);
+	}
+
+	NETLM_EXPORT void InvokeBatch(const void* target, const void* const* columns, size_t count, void* results) {
+		if (target) {
+			g_netlm.InvokeBatch(static_cast<const HandleData*>(target), columns, count, results);
+		}
+	}
+
 	NETLM_EXPORT ILanguageModule* GetLanguageModule() {
 		return &g_netlm;
 	}
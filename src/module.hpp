@@ -13,6 +13,7 @@
 
 #include "host_instance.hpp"
 #include "managed_assembly.hpp"
+#include "post_queue.hpp"
 
 using namespace plugify;
 
@@ -23,12 +24,13 @@ namespace netlm {
 		MethodInfo method;
 		bool error;
 
-		ScriptMethod(ManagedObject instance, std::string_view methodName);
+		ScriptMethod(Type& type, std::string_view methodName);
+		ScriptMethod(MethodInfo info, bool hasError) : method{info}, error{hasError} {}
 	};
 
 	class ScriptInstance {
 	public:
-		ScriptInstance(const Extension& plugin, ManagedGuid assembly, Type& type);
+		ScriptInstance(const Extension& plugin, ManagedGuid assembly, Type& type, ScriptMethod update, ScriptMethod start, ScriptMethod end);
 		~ScriptInstance();
 
 		const Extension& GetPlugin() const { return _plugin; }
@@ -46,6 +48,10 @@ namespace netlm {
 		bool HasUpdate() const;
 		bool HasEnd() const;
 
+		// Ticked by DotnetLanguageModule::OnUpdate together with the other plugins instead of per plugin
+		bool IsUpdateBatched() const { return _batchedUpdate; }
+		void SetUpdateEnabled(bool enabled) const;
+
 	private:
 		const Extension& _plugin;
 		ManagedGuid _assembly;
@@ -53,11 +59,42 @@ namespace netlm {
 		ScriptMethod _update;
 		ScriptMethod _start;
 		ScriptMethod _end;
+		bool _batchedUpdate{};
 	};
 
 	struct SharpMethodData;
 
-	using HandleData = std::pair<ManagedHandle, ManagedHandle>;
+	// Argument layout of a method, resolved once so calls don't have to switch over the signature
+	struct CallPlan {
+		std::array<bool, Signature::kMaxFuncArgs> byValue{}; // slot holds the value itself, pass its address
+		void(*constructReturn)(void*){}; // null when the return slot holds a plain value
+		bool hasReturn{};
+		size_t paramCount{};
+		std::array<uint32_t, Signature::kMaxFuncArgs> strides{}; // element size of each argument column in a batch
+		uint32_t returnStride{};
+		bool batchable{}; // false when a function pointer is passed by value, it has no column layout
+	};
+
+	struct HandleData {
+		ManagedHandle type;
+		ManagedHandle method;
+		ExportThunk thunk; // null when the signature has to go through the reflection invoker
+		CallPlan plan;
+	};
+
+	// Delegate handed to native code as a function, its plan is compiled once when the callback is created
+	struct DelegateCallback {
+		JitCallback callback;
+		ManagedHandle delegate{};
+		CallPlan plan;
+	};
+
+	// Exports of one plugin, bound to the function pointer fields of its generated class in other assemblies
+	struct InternalCallTable {
+		ManagedGuid owner; // assembly of a C# plugin, which doesn't bind its own exports
+		std::vector<std::pair<std::string, void*>> calls;
+	};
+
 	using ScriptMap = std::map<UniqueId, ScriptInstance>;
 	using FunctionList = std::vector<SharpMethodData>;
 	using ArgumentList = std::inplace_vector<const void*, Signature::kMaxFuncArgs>;
@@ -67,6 +104,13 @@ namespace netlm {
 		std::unique_ptr<HandleData> sharpFunction;
 	};
 
+	// Export handed to plugify as its generated stub, the handle data is only bound once it is posted to or batched
+	struct GeneratedExport {
+		const Method* method;
+		ManagedGuid assembly;
+		std::optional<SharpMethodData> binding;
+	};
+
 	class DotnetLanguageModule final : public ILanguageModule {
 	public:
 		DotnetLanguageModule() = default;
@@ -88,16 +132,31 @@ namespace netlm {
 		const ScriptInstance* FindScript(UniqueId pluginId) const;
 		std::shared_ptr<Method> FindMethod(std::string_view name) const;
 
+		// Resolve on the main thread, then post from any thread. Runs during the next OnUpdate.
+		const HandleData* FindPostTarget(void* function);
+		bool Post(const HandleData* target, const uint64_t* args, size_t count);
+
+		// Runs the export over `count` rows of columnar arguments with a single managed transition
+		const HandleData* FindBatchTarget(void* function);
+		void InvokeBatch(const HandleData* target, const void* const* columns, size_t count, void* results) const;
+
 		const std::unique_ptr<Provider>& GetProvider() { return _provider; }
 		const std::shared_ptr<ILogger>& GetLogger() { return _logger; }
 		const std::shared_ptr<IProfiler>& GetProfiler() const { return _profiler; }
 
 		static Result<SharpMethodData> GenerateMethodExport(const Method& method, ManagedAssembly &assembly);
+		static Result<SharpMethodData> BindMethodExport(const Method& method, ManagedHandle typeHandle, ManagedHandle methodHandle);
+		static std::optional<CallPlan> CompileCallPlan(const Method& method);
 
 		static void InternalCall(const Method* method, Address data, uint64_t* p, size_t count, void* ret);
 		static void DelegateCall(const Method* method, Address data, uint64_t* p, size_t count, void* ret);
 
 	private:
+		void FlushInternalCalls();
+		void ForgetInternalCalls(ManagedGuid assemblyId);
+		void DrainPostedCalls();
+		const HandleData* FindExportData(void* function);
+
 		static void ExceptionCallback(std::string_view message);
 		static void MessageCallback(std::string_view message, MessageLevel level);
 
@@ -111,6 +170,14 @@ namespace netlm {
 
 		ScriptMap _scripts;
 		FunctionList _functions;
+		std::unordered_map<void*, GeneratedExport> _generatedExports;
+
+		StringMap<InternalCallTable> _internalCallTables;
+		std::vector<std::string> _pendingInternalCalls;
+		std::unordered_set<ManagedGuid> _boundAssemblies;
+
+		PostQueue _postedCalls{4096};
+		std::vector<std::array<uint64_t, kMaxPostedArgs>> _postedRows; // arguments of a run of posted calls to one export
 	};
 
 	extern DotnetLanguageModule g_netlm;
@@ -29,17 +29,6 @@ PLUGIFY_FORCE_INLINE plg::vector<T> ConstructVector(T* arr, int len) {
 		return plg::vector<T>(arr, arr + len);
 }
 
-template<typename T> requires(std::is_same_v<T, char*>)
-PLUGIFY_FORCE_INLINE plg::vector<plg::string> ConstructVector(T* arr, int len) {
-	if (arr == nullptr || len == 0) [[unlikely]]
-		if (len > 0)
-			return plg::vector<plg::string>(static_cast<size_t>(len));
-		else
-			return {};
-	else
-		return plg::vector<plg::string>(arr, arr + len);
-}
-
 template<typename T>
 PLUGIFY_FORCE_INLINE void DestroyVector(plg::vector<T>* vector) {
 	vector->~vector();
@@ -57,14 +46,6 @@ PLUGIFY_FORCE_INLINE void GetVectorData(plg::vector<T>* vector, T* arr) {
 	}
 }
 
-template<typename T> requires(std::is_same_v<T, char*>)
-PLUGIFY_FORCE_INLINE void GetVectorData(plg::vector<plg::string>* vector, T* arr) {
-	for (size_t i = 0; i < vector->size(); ++i) {
-		Memory::FreeCoTaskMem(arr[i]);
-		arr[i] = Memory::StringToHGlobalAnsi((*vector)[i]);
-	}
-}
-
 template<typename T> requires(!std::is_same_v<T, char*>)
 PLUGIFY_FORCE_INLINE void AssignVector(plg::vector<T>* vector, T* arr, int len) {
 	if (arr == nullptr || len == 0) [[unlikely]]
@@ -73,12 +54,50 @@ PLUGIFY_FORCE_INLINE void AssignVector(plg::vector<T>* vector, T* arr, int len)
 		vector->assign(arr, arr + len);
 }
 
-template<typename T> requires(std::is_same_v<T, char*>)
-PLUGIFY_FORCE_INLINE void AssignVector(plg::vector<plg::string>* vector, T* arr, int len) {
-	if (arr == nullptr || len == 0) [[unlikely]]
+// Strings arrive packed: the UTF-8 bytes of every element back to back, element i spans [offsets[i], offsets[i + 1])
+PLUGIFY_FORCE_INLINE plg::vector<plg::string> ConstructVectorPacked(const char* data, const int* offsets, int len) {
+	plg::vector<plg::string> vector;
+	if (offsets == nullptr || len <= 0) [[unlikely]]
+		return vector;
+	vector.reserve(static_cast<size_t>(len));
+	for (int i = 0; i < len; ++i) {
+		vector.emplace_back(data + offsets[i], static_cast<size_t>(offsets[i + 1] - offsets[i]));
+	}
+	return vector;
+}
+
+// Packs the other way: offsets are always filled, the bytes only when all of them fit into capacity.
+// Returns the byte count the elements need, so a caller whose buffer was too small can retry once.
+PLUGIFY_FORCE_INLINE int GetVectorDataPacked(const plg::vector<plg::string>* vector, char* data, int capacity, int* offsets) {
+	size_t byteCount = 0;
+	for (size_t i = 0; i < vector->size(); ++i) {
+		offsets[i] = static_cast<int>(byteCount);
+		byteCount += (*vector)[i].size();
+	}
+	offsets[vector->size()] = static_cast<int>(byteCount);
+	if (byteCount <= static_cast<size_t>(capacity)) {
+		for (size_t i = 0; i < vector->size(); ++i) {
+			std::memcpy(data + offsets[i], (*vector)[i].data(), (*vector)[i].size());
+		}
+	}
+	return static_cast<int>(byteCount);
+}
+
+// Elements already present keep their buffers, only longer strings reallocate
+PLUGIFY_FORCE_INLINE void AssignVectorPacked(plg::vector<plg::string>* vector, const char* data, const int* offsets, int len) {
+	if (offsets == nullptr || len <= 0) [[unlikely]] {
 		vector->clear();
-	else
-		vector->assign(arr, arr + len);
+		return;
+	}
+	vector->resize(static_cast<size_t>(len));
+	for (int i = 0; i < len; ++i) {
+		(*vector)[static_cast<size_t>(i)].assign(data + offsets[i], static_cast<size_t>(offsets[i + 1] - offsets[i]));
+	}
+}
+
+template<typename T>
+PLUGIFY_FORCE_INLINE void ResizeVector(plg::vector<T>* vector, int size) {
+	vector->resize(static_cast<size_t>(size));
 }
 
 namespace plg {
@@ -108,11 +127,11 @@ namespace plg {
 extern "C" {
 	// String Functions
 
-	NETLM_EXPORT plg::string ConstructString(const char* source) {
-		if (source == nullptr) [[unlikely]]
+	NETLM_EXPORT plg::string ConstructString(const char* source, int length) {
+		if (source == nullptr || length == 0) [[unlikely]]
 			return {};
 		else
-			return { source };
+			return { source, static_cast<size_t>(length) };
 	}
 	NETLM_EXPORT void DestroyString(plg::string* string) {
 		string->~basic_string();
@@ -120,14 +139,14 @@ extern "C" {
 	NETLM_EXPORT int GetStringLength(plg::string* string) {
 		return static_cast<int>(string->length());
 	}
-	NETLM_EXPORT const char* GetStringData(plg::string* string) {
-		return Memory::StringToHGlobalAnsi(*string);
+	NETLM_EXPORT const char* GetStringPointer(plg::string* string) {
+		return string->data();
 	}
-	NETLM_EXPORT void AssignString(plg::string* string, const char* source) {
-		if (source == nullptr) [[unlikely]]
+	NETLM_EXPORT void AssignString(plg::string* string, const char* source, int length) {
+		if (source == nullptr || length == 0) [[unlikely]]
 			string->clear();
 		else
-			string->assign(source);
+			string->assign(source, static_cast<size_t>(length));
 	}
 
 	// Variant Functions
@@ -151,7 +170,7 @@ extern "C" {
 	NETLM_EXPORT plg::vector<uintptr_t> ConstructVectorIntPtr(uintptr_t* arr, int len) { return ConstructVector(arr, len); }
 	NETLM_EXPORT plg::vector<float> ConstructVectorFloat(float* arr, int len) { return ConstructVector(arr, len); }
 	NETLM_EXPORT plg::vector<double> ConstructVectorDouble(double* arr, int len) { return ConstructVector(arr, len); }
-	NETLM_EXPORT plg::vector<plg::string> ConstructVectorString(char* arr[], int len) { return ConstructVector(arr, len); }
+	NETLM_EXPORT plg::vector<plg::string> ConstructVectorString(const char* data, const int* offsets, int len) { return ConstructVectorPacked(data, offsets, len); }
 	NETLM_EXPORT plg::raw::vector ConstructVectorVariant(int len) {
 		plg::vector<plg::any> ret(static_cast<size_t>(len));
 		return plg::as_raw<plg::raw::vector>(std::move(ret));
@@ -224,13 +243,53 @@ extern "C" {
 	NETLM_EXPORT void GetVectorDataIntPtr(plg::vector<uintptr_t>* vector, uintptr_t* arr) { GetVectorData(vector, arr); }
 	NETLM_EXPORT void GetVectorDataFloat(plg::vector<float>* vector, float* arr) { GetVectorData(vector, arr); }
 	NETLM_EXPORT void GetVectorDataDouble(plg::vector<double>* vector, double* arr) { GetVectorData(vector, arr); }
-	NETLM_EXPORT void GetVectorDataString(plg::vector<plg::string>* vector, char* arr[]) { GetVectorData(vector, arr); }
+	NETLM_EXPORT int GetVectorDataString(plg::vector<plg::string>* vector, char* data, int capacity, int* offsets) { return GetVectorDataPacked(vector, data, capacity, offsets); }
 	NETLM_EXPORT plg::any* GetVectorDataVariant(plg::vector<plg::any>* vector, int at) { return &vector->at(static_cast<size_t>(at)); }
 	NETLM_EXPORT void GetVectorDataVector2(plg::vector<plg::vec2>* vector, plg::vec2* arr) { GetVectorData(vector, arr); }
 	NETLM_EXPORT void GetVectorDataVector3(plg::vector<plg::vec3>* vector, plg::vec3* arr) { GetVectorData(vector, arr); }
 	NETLM_EXPORT void GetVectorDataVector4(plg::vector<plg::vec4>* vector, plg::vec4* arr) { GetVectorData(vector, arr); }
 	NETLM_EXPORT void GetVectorDataMatrix4x4(plg::vector<plg::mat4x4>* vector, plg::mat4x4* arr) { GetVectorData(vector, arr); }
 
+	// GetVectorPointer Functions, the buffer is viewed in place by Span parameters
+
+	NETLM_EXPORT char* GetVectorPointerChar8(plg::vector<char>* vector) { return vector->data(); }
+	NETLM_EXPORT char16_t* GetVectorPointerChar16(plg::vector<char16_t>* vector) { return vector->data(); }
+	NETLM_EXPORT int8_t* GetVectorPointerInt8(plg::vector<int8_t>* vector) { return vector->data(); }
+	NETLM_EXPORT int16_t* GetVectorPointerInt16(plg::vector<int16_t>* vector) { return vector->data(); }
+	NETLM_EXPORT int32_t* GetVectorPointerInt32(plg::vector<int32_t>* vector) { return vector->data(); }
+	NETLM_EXPORT int64_t* GetVectorPointerInt64(plg::vector<int64_t>* vector) { return vector->data(); }
+	NETLM_EXPORT uint8_t* GetVectorPointerUInt8(plg::vector<uint8_t>* vector) { return vector->data(); }
+	NETLM_EXPORT uint16_t* GetVectorPointerUInt16(plg::vector<uint16_t>* vector) { return vector->data(); }
+	NETLM_EXPORT uint32_t* GetVectorPointerUInt32(plg::vector<uint32_t>* vector) { return vector->data(); }
+	NETLM_EXPORT uint64_t* GetVectorPointerUInt64(plg::vector<uint64_t>* vector) { return vector->data(); }
+	NETLM_EXPORT uintptr_t* GetVectorPointerIntPtr(plg::vector<uintptr_t>* vector) { return vector->data(); }
+	NETLM_EXPORT float* GetVectorPointerFloat(plg::vector<float>* vector) { return vector->data(); }
+	NETLM_EXPORT double* GetVectorPointerDouble(plg::vector<double>* vector) { return vector->data(); }
+	NETLM_EXPORT plg::vec2* GetVectorPointerVector2(plg::vector<plg::vec2>* vector) { return vector->data(); }
+	NETLM_EXPORT plg::vec3* GetVectorPointerVector3(plg::vector<plg::vec3>* vector) { return vector->data(); }
+	NETLM_EXPORT plg::vec4* GetVectorPointerVector4(plg::vector<plg::vec4>* vector) { return vector->data(); }
+	NETLM_EXPORT plg::mat4x4* GetVectorPointerMatrix4x4(plg::vector<plg::mat4x4>* vector) { return vector->data(); }
+
+	// ResizeVector Functions, used by NativeVector to grow the caller's vector in place
+
+	NETLM_EXPORT void ResizeVectorChar8(plg::vector<char>* vector, int size) { ResizeVector(vector, size); }
+	NETLM_EXPORT void ResizeVectorChar16(plg::vector<char16_t>* vector, int size) { ResizeVector(vector, size); }
+	NETLM_EXPORT void ResizeVectorInt8(plg::vector<int8_t>* vector, int size) { ResizeVector(vector, size); }
+	NETLM_EXPORT void ResizeVectorInt16(plg::vector<int16_t>* vector, int size) { ResizeVector(vector, size); }
+	NETLM_EXPORT void ResizeVectorInt32(plg::vector<int32_t>* vector, int size) { ResizeVector(vector, size); }
+	NETLM_EXPORT void ResizeVectorInt64(plg::vector<int64_t>* vector, int size) { ResizeVector(vector, size); }
+	NETLM_EXPORT void ResizeVectorUInt8(plg::vector<uint8_t>* vector, int size) { ResizeVector(vector, size); }
+	NETLM_EXPORT void ResizeVectorUInt16(plg::vector<uint16_t>* vector, int size) { ResizeVector(vector, size); }
+	NETLM_EXPORT void ResizeVectorUInt32(plg::vector<uint32_t>* vector, int size) { ResizeVector(vector, size); }
+	NETLM_EXPORT void ResizeVectorUInt64(plg::vector<uint64_t>* vector, int size) { ResizeVector(vector, size); }
+	NETLM_EXPORT void ResizeVectorIntPtr(plg::vector<uintptr_t>* vector, int size) { ResizeVector(vector, size); }
+	NETLM_EXPORT void ResizeVectorFloat(plg::vector<float>* vector, int size) { ResizeVector(vector, size); }
+	NETLM_EXPORT void ResizeVectorDouble(plg::vector<double>* vector, int size) { ResizeVector(vector, size); }
+	NETLM_EXPORT void ResizeVectorVector2(plg::vector<plg::vec2>* vector, int size) { ResizeVector(vector, size); }
+	NETLM_EXPORT void ResizeVectorVector3(plg::vector<plg::vec3>* vector, int size) { ResizeVector(vector, size); }
+	NETLM_EXPORT void ResizeVectorVector4(plg::vector<plg::vec4>* vector, int size) { ResizeVector(vector, size); }
+	NETLM_EXPORT void ResizeVectorMatrix4x4(plg::vector<plg::mat4x4>* vector, int size) { ResizeVector(vector, size); }
+
 	// AssignVector Functions
 
 	NETLM_EXPORT void AssignVectorBool(plg::vector<bool>* vector, bool* arr, int len) { AssignVector(vector, arr, len); }
@@ -247,7 +306,7 @@ extern "C" {
 	NETLM_EXPORT void AssignVectorIntPtr(plg::vector<uintptr_t>* vector, uintptr_t* arr, int len) { AssignVector(vector, arr, len); }
 	NETLM_EXPORT void AssignVectorFloat(plg::vector<float>* vector, float* arr, int len) { AssignVector(vector, arr, len); }
 	NETLM_EXPORT void AssignVectorDouble(plg::vector<double>* vector, double* arr, int len) { AssignVector(vector, arr, len); }
-	NETLM_EXPORT void AssignVectorString(plg::vector<plg::string>* vector, char* arr[], int len) { AssignVector(vector, arr, len); }
+	NETLM_EXPORT void AssignVectorString(plg::vector<plg::string>* vector, const char* data, const int* offsets, int len) { AssignVectorPacked(vector, data, offsets, len); }
 	NETLM_EXPORT void AssignVectorVariant(plg::vector<plg::any>* vector, int len) { vector->resize(static_cast<size_t>(len)); }
 	NETLM_EXPORT void AssignVectorVector2(plg::vector<plg::vec2>* vector, plg::vec2* arr, int len) { AssignVector(vector, arr, len); }
 	NETLM_EXPORT void AssignVectorVector3(plg::vector<plg::vec3>* vector, plg::vec3* arr, int len) { AssignVector(vector, arr, len); }
@@ -299,25 +358,31 @@ extern "C" {
 		return Memory::StringToHGlobalAnsi(call ? call->GetError().data() : "Target invalid");
 	}
 
-	NETLM_EXPORT JitCallback* NewCallback(const char* name, void* delegate) {
+	NETLM_EXPORT DelegateCallback* NewCallback(const char* name, void* delegate) {
 		std::shared_ptr<Method> method = g_netlm.FindMethod(name);
 		if (method == nullptr || delegate == nullptr)
 			return nullptr;
 
-		JitCallback* callback = new JitCallback{};
-		callback->GetJitFunc(*method, &DotnetLanguageModule::DelegateCall, delegate);
+		auto plan = DotnetLanguageModule::CompileCallPlan(*method);
+		if (!plan)
+			return nullptr;
+
+		DelegateCallback* callback = new DelegateCallback{};
+		callback->delegate = delegate;
+		callback->plan = *plan;
+		callback->callback.GetJitFunc(*method, &DotnetLanguageModule::DelegateCall, callback);
 		return callback;
 	}
 
-	NETLM_EXPORT void DeleteCallback(JitCallback* callback) {
+	NETLM_EXPORT void DeleteCallback(DelegateCallback* callback) {
 		delete callback;
 	}
 
-	NETLM_EXPORT void* GetCallbackFunction(JitCallback* callback) {
-		return callback ? callback->GetFunction() : nullptr;
+	NETLM_EXPORT void* GetCallbackFunction(DelegateCallback* callback) {
+		return callback ? callback->callback.GetFunction() : nullptr;
 	}
 
-	NETLM_EXPORT char* GetCallbackError(JitCallback* callback) {
-		return Memory::StringToHGlobalAnsi(callback ? callback->GetError().data() : "Method invalid");
+	NETLM_EXPORT char* GetCallbackError(DelegateCallback* callback) {
+		return Memory::StringToHGlobalAnsi(callback ? callback->callback.GetError().data() : "Method invalid");
 	}
 }
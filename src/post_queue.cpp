@@ -0,0 +1,41 @@
+#include "post_queue.hpp"
+
+#include <algorithm>
+#include <bit>
+
+using namespace netlm;
+
+PostQueue::PostQueue(size_t capacity) : _cells{std::make_unique<Cell[]>(std::bit_ceil(capacity))}, _mask{std::bit_ceil(capacity) - 1} {
+	for (size_t i = 0; i <= _mask; ++i) {
+		_cells[i].sequence.store(i, std::memory_order_relaxed);
+	}
+}
+
+bool PostQueue::TryPush(const void* target, const uint64_t* args, size_t count) {
+	if (count > kMaxPostedArgs) {
+		return false;
+	}
+
+	size_t head = _head.load(std::memory_order_relaxed);
+	for (;;) {
+		Cell& cell = _cells[head & _mask];
+		size_t sequence = cell.sequence.load(std::memory_order_acquire);
+		auto diff = static_cast<ptrdiff_t>(sequence) - static_cast<ptrdiff_t>(head);
+		if (diff == 0) {
+			// Slot is free for this lap, claim it
+			if (_head.compare_exchange_weak(head, head + 1, std::memory_order_relaxed)) {
+				cell.call.target = target;
+				cell.call.count = static_cast<uint32_t>(count);
+				std::copy_n(args, count, cell.call.args.begin());
+				cell.sequence.store(head + 1, std::memory_order_release);
+				return true;
+			}
+		} else if (diff < 0) {
+			// Consumer hasn't freed this slot from the previous lap, the ring is full
+			_dropped.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		} else {
+			head = _head.load(std::memory_order_relaxed);
+		}
+	}
+}
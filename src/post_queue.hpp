@@ -0,0 +1,62 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace netlm {
+	constexpr size_t kMaxPostedArgs = 8;
+
+	/// Call posted from any thread, to run later on the main thread. Arguments are stored by value.
+	struct PostedCall {
+		const void* target;
+		uint32_t count;
+		std::array<uint64_t, kMaxPostedArgs> args;
+	};
+
+	/// Bounded multi-producer/single-consumer ring. Every cell carries a sequence number, so producers
+	/// claim a slot with one CAS and never wait on each other or on the consumer: a full ring rejects the push.
+	class PostQueue {
+	public:
+		explicit PostQueue(size_t capacity);
+
+		PostQueue(const PostQueue&) = delete;
+		PostQueue& operator=(const PostQueue&) = delete;
+
+		bool TryPush(const void* target, const uint64_t* args, size_t count);
+
+		/// Consumer side, hands out at most `max` calls, in the order they were claimed.
+		template<typename F>
+		size_t Drain(size_t max, F&& func) {
+			size_t drained = 0;
+			while (drained < max) {
+				Cell& cell = _cells[_tail & _mask];
+				if (cell.sequence.load(std::memory_order_acquire) != _tail + 1) {
+					break;
+				}
+				func(cell.call);
+				cell.sequence.store(_tail + _mask + 1, std::memory_order_release);
+				++_tail;
+				++drained;
+			}
+			return drained;
+		}
+
+		size_t GetCapacity() const { return _mask + 1; }
+		size_t TakeDropped() { return _dropped.exchange(0, std::memory_order_relaxed); }
+
+	private:
+		struct alignas(64) Cell {
+			std::atomic<size_t> sequence;
+			PostedCall call;
+		};
+
+		std::unique_ptr<Cell[]> _cells;
+		size_t _mask;
+		alignas(64) std::atomic<size_t> _head{};
+		alignas(64) size_t _tail{};
+		std::atomic<size_t> _dropped{};
+	};
+}
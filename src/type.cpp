@@ -45,6 +45,22 @@ bool Type::IsAssignableFrom(const Type& other) const {
 	return Managed.IsTypeAssignableFromFptr(_handle, other._handle);
 }
 
+// Handles are kept per name, unknown names included, so a repeated lookup doesn't allocate or leave native code
+template<typename TGetMember>
+static ManagedHandle FindMember(StringMap<ManagedHandle>& members, ManagedHandle typeHandle, std::string_view memberName, TGetMember getMember) {
+	if (auto it = members.find(memberName); it != members.end()) {
+		return it->second;
+	}
+
+	auto name = String::New(memberName);
+	ManagedHandle handle{};
+	getMember(typeHandle, name, &handle);
+	String::Free(name);
+
+	members.try_emplace(std::string(memberName), handle);
+	return handle;
+}
+
 std::vector<MethodInfo> Type::GetMethods() const {
 	int32_t methodCount = 0;
 	Managed.GetTypeMethodsFptr(_handle, nullptr, &methodCount);
@@ -88,30 +104,15 @@ std::vector<PropertyInfo> Type::GetProperties() const {
 }
 
 MethodInfo Type::GetMethod(std::string_view methodName) const {
-	auto name = String::New(methodName);
-	ManagedHandle handle{};
-	Managed.GetTypeMethodFptr(_handle, name, &handle);
-	String::Free(name);
-
-	return handle;
+	return FindMember(_methods, _handle, methodName, Managed.GetTypeMethodFptr);
 }
 
 FieldInfo Type::GetField(std::string_view fieldName) const {
-	auto name = String::New(fieldName);
-	ManagedHandle handle{};
-	Managed.GetTypeFieldFptr(_handle, name, &handle);
-	String::Free(name);
-
-	return handle;
+	return FindMember(_fields, _handle, fieldName, Managed.GetTypeFieldFptr);
 }
 
 PropertyInfo Type::GetProperty(std::string_view propertyName) const {
-	auto name = String::New(propertyName);
-	ManagedHandle handle{};
-	Managed.GetTypePropertyFptr(_handle, name, &handle);
-	String::Free(name);
-
-	return handle;
+	return FindMember(_properties, _handle, propertyName, Managed.GetTypePropertyFptr);
 }
 
 bool Type::HasAttribute(const Type& attributeType) const {
@@ -188,8 +189,6 @@ Type& Type::GetElementType() {
 	return *_elementType;
 }
 
-// TODO: Cache methods
-
 ManagedObject Type::CreateInstanceInternal(const void** parameters, size_t length) const {
 	ManagedHandle handle = Managed.CreateObjectFptr(_handle, false, parameters, static_cast<int32_t>(length));
 	return ManagedObject{ handle, const_cast<Type*>(this) };
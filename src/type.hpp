@@ -7,6 +7,7 @@
 #include "method_info.hpp"
 #include "native_string.hpp"
 #include "property_info.hpp"
+#include "utils.hpp"
 
 namespace netlm {
 	class Type {
@@ -115,5 +116,8 @@ namespace netlm {
 		ManagedHandle _handle{};
 		Type* _baseType{};
 		Type* _elementType{};
+		mutable StringMap<ManagedHandle> _methods;
+		mutable StringMap<ManagedHandle> _fields;
+		mutable StringMap<ManagedHandle> _properties;
 	};
 }
@@ -1,4 +1,5 @@
 #include "type_cache.hpp"
+#include "managed_functions.hpp"
 
 using namespace netlm;
 
@@ -9,9 +10,39 @@ TypeCache& TypeCache::Get() {
 }
 
 Type* TypeCache::Add(ManagedHandle handle) {
-    return &m_types.emplace_back(handle);
+    auto [it, inserted] = m_types.try_emplace(handle, handle);
+    if (!inserted) {
+        ++m_hits;
+        return &it->second;
+    }
+
+    ++m_misses;
+
+    // Shared types (BCL, Plugify) stay until Clear
+    if (handle) {
+        if (ManagedGuid assemblyId = Managed.GetTypeAssemblyIdFptr(handle)) {
+            m_assemblyTypes[assemblyId].emplace_back(handle);
+        }
+    }
+
+    return &it->second;
+}
+
+void TypeCache::Remove(ManagedGuid assemblyId) {
+    auto it = m_assemblyTypes.find(assemblyId);
+    if (it == m_assemblyTypes.end()) {
+        return;
+    }
+
+    for (ManagedHandle handle : it->second) {
+        m_types.erase(handle);
+    }
+    m_assemblyTypes.erase(it);
 }
 
 void TypeCache::Clear() {
     m_types.clear();
-}
\ No newline at end of file
+    m_assemblyTypes.clear();
+    m_hits = 0;
+    m_misses = 0;
+}
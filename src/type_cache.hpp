@@ -3,15 +3,30 @@
 #include "type.hpp"
 
 namespace netlm {
+    /// Owns every Type handed out by reference, one entry per managed handle.
+    /// Entries are grouped by the plugin assembly that owns them so they go away with it.
     class TypeCache {
     public:
+        struct Stats {
+            size_t hits;
+            size_t misses;
+            size_t size;
+        };
+
         static TypeCache& Get();
 
         Type* Add(ManagedHandle handle);
 
+        void Remove(ManagedGuid assemblyId);
         void Clear();
 
+        Stats GetStats() const { return { m_hits, m_misses, m_types.size() }; }
+
     private:
-        std::deque<Type> m_types;
+        // Node based, so Type* stays valid while other entries come and go
+        std::unordered_map<ManagedHandle, Type> m_types;
+        std::unordered_map<ManagedGuid, std::vector<ManagedHandle>> m_assemblyTypes;
+        size_t m_hits{};
+        size_t m_misses{};
     };
-}
\ No newline at end of file
+}
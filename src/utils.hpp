@@ -29,4 +29,13 @@ namespace netlm {
 
 		static std::vector<std::string_view> Split(std::string_view strv, std::string_view delims = " ");
 	};
+
+	/// Transparent hash, lets string keyed maps be searched with std::string_view.
+	struct StringHash {
+		using is_transparent = void;
+		size_t operator()(std::string_view str) const noexcept { return std::hash<std::string_view>{}(str); }
+	};
+
+	template<typename T>
+	using StringMap = std::unordered_map<std::string, T, StringHash, std::equal_to<>>;
 }
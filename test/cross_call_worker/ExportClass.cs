@@ -1786,6 +1786,78 @@ public class ExportClass
         return result;
     }
     
+    // Views over native memory
+
+    public static int ParamSpanInt32(ReadOnlySpan<int> values)
+    {
+        int sum = 0;
+        foreach (int value in values)
+        {
+            sum += value;
+        }
+        return sum;
+    }
+
+    public static float ParamSpanScaleFloat(Span<float> values, float factor)
+    {
+        float sum = 0;
+        foreach (float value in values)
+        {
+            sum += value * factor;
+        }
+        return sum;
+    }
+
+    public static int ParamNativeVectorInt32(NativeVector<int> values, int value)
+    {
+        values.Add(value);
+        return values.Count;
+    }
+
+    public static int ParamStringView(NativeStringView text)
+    {
+        return text.StartsWith("Hello"u8) ? text.Length : -1;
+    }
+
+    // Async exports, completed through the trailing callback
+
+    public static async Task<int> AsyncSumInt32(int a, int b)
+    {
+        await Task.Yield();
+        return a + b;
+    }
+
+    public static async Task AsyncNoResult()
+    {
+        await Task.Yield();
+        _asyncCompleted++;
+    }
+
+    public static int GetAsyncCompleted()
+    {
+        return _asyncCompleted;
+    }
+
+    // Posted and batched calls
+
+    public static void PostedAccumulate(int value)
+    {
+        _postedTotal += value;
+    }
+
+    public static long GetPostedTotal()
+    {
+        return _postedTotal;
+    }
+
+    public static float BatchMultiplyAdd(float a, float b, float c)
+    {
+        return a * b + c;
+    }
+
+    private static int _asyncCompleted;
+    private static long _postedTotal;
+
     static unsafe void ReverseCall(string test)
     {
         if (ReverseClass.ReverseTest.TryGetValue(test, out var method))
@@ -1508,6 +1508,13 @@ public unsafe class ReverseClass
         { "ClassMemoryLeakDetection", TestClass.MemoryLeakDetection },
         { "ClassExceptionHandling", TestClass.ExceptionHandling },
         { "ClassOwnershipTransfer", TestClass.OwnershipTransfer },
+        
+        { "ContextPost", SchedulerClass.ContextPost },
+        { "ContextSend", SchedulerClass.ContextSend },
+        { "ContextAwait", SchedulerClass.ContextAwait },
+        { "TimerCascade", SchedulerClass.TimerCascade },
+        { "TimerRepeat", SchedulerClass.TimerRepeat },
+        { "TimerCancelInsideCallback", SchedulerClass.TimerCancelInsideCallback },
     };
     
 }
\ No newline at end of file
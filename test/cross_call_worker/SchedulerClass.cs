@@ -0,0 +1,203 @@
+﻿using System;
+using System.Diagnostics;
+using System.Reflection;
+using System.Threading;
+using Plugify;
+
+namespace cross_call_worker;
+
+public class SchedulerClass
+{
+    [Conditional("VERBOSE")]
+    static void Log(string message)
+    {
+        Console.WriteLine(message);
+    }
+
+    // The host drives both once per frame, the tests drive them by hand to stay deterministic
+    static readonly Action<float> AdvanceTimers = typeof(Timers)
+        .GetMethod("Advance", BindingFlags.NonPublic | BindingFlags.Static)!
+        .CreateDelegate<Action<float>>();
+
+    static readonly Action<long> PumpContinuations = typeof(MainThreadSynchronizationContext)
+        .GetMethod("Pump", BindingFlags.NonPublic | BindingFlags.Instance)!
+        .CreateDelegate<Action<long>>(MainThreadSynchronizationContext.Instance);
+
+    static bool PumpUntil(Func<bool> condition)
+    {
+        var timeout = Stopwatch.StartNew();
+        while (!condition())
+        {
+            if (timeout.ElapsedMilliseconds > 1000)
+                return false;
+
+            PumpContinuations(0);
+            Thread.Sleep(1);
+        }
+        return true;
+    }
+
+    public static string ContextPost()
+    {
+        Log("TEST: Synchronization context post");
+
+        var context = MainThreadSynchronizationContext.Instance;
+        if (SynchronizationContext.Current != context || !context.IsMainThread)
+        {
+            Log("x The host thread context is not installed");
+            return "false";
+        }
+
+        int threadId = -1;
+        context.Post(_ => threadId = Environment.CurrentManagedThreadId, null);
+        if (threadId != -1)
+        {
+            Log("x Posted callback ran inline");
+            return "false";
+        }
+
+        PumpContinuations(0);
+        if (threadId != Environment.CurrentManagedThreadId)
+        {
+            Log("x Posted callback did not run on the host thread");
+            return "false";
+        }
+
+        Log("v Posted callback ran on the next pump");
+        return "true";
+    }
+
+    public static string ContextSend()
+    {
+        Log("TEST: Synchronization context send");
+
+        var context = MainThreadSynchronizationContext.Instance;
+
+        bool inline = false;
+        context.Send(_ => inline = true, null);
+
+        // From another thread Send blocks until the host thread pumped the callback
+        int threadId = -1;
+        var worker = Task.Run(() => context.Send(_ => threadId = Environment.CurrentManagedThreadId, null));
+
+        if (!inline || !PumpUntil(() => worker.IsCompleted) || worker.IsFaulted || threadId != Environment.CurrentManagedThreadId)
+        {
+            Log("x Send did not run on the host thread");
+            return "false";
+        }
+
+        Log("v Send ran inline on the host thread and through the pump from a worker");
+        return "true";
+    }
+
+    public static string ContextAwait()
+    {
+        Log("TEST: Synchronization context await");
+
+        var task = ResumeOnHostThread();
+
+        if (!PumpUntil(() => task.IsCompleted) || task.IsFaulted || task.Result != Environment.CurrentManagedThreadId)
+        {
+            Log("x Continuation did not resume on the host thread");
+            return "false";
+        }
+
+        Log("v Continuation resumed on the host thread");
+        return "true";
+    }
+
+    static async Task<int> ResumeOnHostThread()
+    {
+        await Task.Run(() => Thread.Sleep(1));
+        return Environment.CurrentManagedThreadId;
+    }
+
+    public static string TimerCascade()
+    {
+        Log("TEST: Timer cascade");
+
+        // Past the 256 slots of the first level, so the timer has to move down a level before it fires
+        int fired = 0;
+        var handle = Timers.Schedule(TimeSpan.FromMilliseconds(300), () => fired++);
+
+        AdvanceTimers(0.25f);
+        if (fired != 0 || !Timers.IsScheduled(handle))
+        {
+            Log("x Timer fired early");
+            Timers.Cancel(handle);
+            return "false";
+        }
+
+        AdvanceTimers(0.0625f);
+        if (fired != 1 || Timers.IsScheduled(handle))
+        {
+            Log($"x Timer fired {fired} times");
+            return "false";
+        }
+
+        Log("v Timer fired once after the cascade");
+        return "true";
+    }
+
+    public static string TimerRepeat()
+    {
+        Log("TEST: Timer repeat");
+
+        int fired = 0;
+        var handle = Timers.Every(TimeSpan.FromMilliseconds(10), () => fired++);
+
+        AdvanceTimers(0.0625f);
+        int firedBeforeCancel = fired;
+        bool cancelled = Timers.Cancel(handle);
+        AdvanceTimers(0.0625f);
+
+        if (firedBeforeCancel != 6 || !cancelled || fired != firedBeforeCancel || Timers.Cancel(handle))
+        {
+            Log($"x Repeating timer fired {firedBeforeCancel} times, then {fired - firedBeforeCancel} after cancel");
+            return "false";
+        }
+
+        Log("v Repeating timer fired on every interval and stopped when cancelled");
+        return "true";
+    }
+
+    public static string TimerCancelInsideCallback()
+    {
+        Log("TEST: Timer cancel inside callback");
+
+        // A repeating timer cancelling itself
+        int selfFired = 0;
+        TimerHandle self = default;
+        self = Timers.Every(TimeSpan.FromMilliseconds(5), () =>
+        {
+            selfFired++;
+            Timers.Cancel(self);
+        });
+
+        // Two timers due on the same tick, whichever runs first cancels the other
+        int pairFired = 0;
+        TimerHandle first = default, second = default;
+        first = Timers.Schedule(TimeSpan.FromMilliseconds(20), () =>
+        {
+            pairFired++;
+            Timers.Cancel(second);
+        });
+        second = Timers.Schedule(TimeSpan.FromMilliseconds(20), () =>
+        {
+            pairFired++;
+            Timers.Cancel(first);
+        });
+
+        AdvanceTimers(0.0625f);
+
+        if (selfFired != 1 || Timers.IsScheduled(self) || pairFired != 1 || Timers.IsScheduled(first) || Timers.IsScheduled(second))
+        {
+            Log($"x Self cancelling timer fired {selfFired} times, paired timers fired {pairFired} times");
+            Timers.Cancel(self);
+            return "false";
+        }
+
+        Log("v Timers cancelled from a callback did not fire again");
+        return "true";
+    }
+}